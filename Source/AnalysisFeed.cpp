@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Analysis feed
+  ==============================================================================
+*/
+
+#include "AnalysisFeed.h"
+
+//==============================================================================
+AnalysisFeed::AnalysisFeed()
+    : juce::Thread("Dre-Dimura analysis"),
+      window(static_cast<size_t>(fftSize)),
+      fftData(static_cast<size_t>(2 * fftSize)),
+      inputHistory(static_cast<size_t>(fftSize)),
+      outputHistory(static_cast<size_t>(fftSize))
+{
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), window.size(),
+                                                             juce::dsp::WindowingFunction<float>::hann, false);
+}
+
+AnalysisFeed::~AnalysisFeed()
+{
+    setActive(false);
+}
+
+void AnalysisFeed::prepare(double newSampleRate)
+{
+    const bool wasActive = isThreadRunning();
+    setActive(false);
+
+    sampleRate = newSampleRate;
+
+    // A quarter of a second: the thread reads every frame, so this only
+    // fills up if it stalls
+    const int ringSize = juce::nextPowerOfTwo(juce::roundToInt(sampleRate / 4.0));
+    inputRing.assign(static_cast<size_t>(ringSize), 0.0f);
+    outputRing.assign(static_cast<size_t>(ringSize), 0.0f);
+    ring = std::make_unique<juce::AbstractFifo>(ringSize);
+
+    setActive(wasActive);
+}
+
+void AnalysisFeed::setActive(bool shouldBeActive)
+{
+    if (shouldBeActive == isThreadRunning())
+        return;
+
+    if (shouldBeActive)
+    {
+        if (ring == nullptr)
+            return;  // Not prepared yet
+
+        std::fill(inputHistory.begin(), inputHistory.end(), 0.0f);
+        std::fill(outputHistory.begin(), outputHistory.end(), 0.0f);
+
+        startThread(juce::Thread::Priority::low);
+        active.store(true, std::memory_order_release);
+    }
+    else
+    {
+        active.store(false, std::memory_order_release);
+        stopThread(1000);
+    }
+}
+
+//==============================================================================
+void AnalysisFeed::pushInput(const float* samples, int numSamples) noexcept
+{
+    writeSize1 = writeSize2 = 0;
+
+    if (! active.load(std::memory_order_acquire) || ring == nullptr)
+        return;
+
+    if (ring->getFreeSpace() < numSamples)
+        return;  // Reader stalled: drop the block rather than wait
+
+    ring->prepareToWrite(numSamples, writeStart1, writeSize1, writeStart2, writeSize2);
+
+    std::copy(samples, samples + writeSize1, inputRing.data() + writeStart1);
+    std::copy(samples + writeSize1, samples + writeSize1 + writeSize2, inputRing.data() + writeStart2);
+}
+
+void AnalysisFeed::pushOutput(const float* samples, int numSamples) noexcept
+{
+    // Only completes a block whose input made it into the ring
+    if (writeSize1 + writeSize2 != numSamples || numSamples == 0)
+        return;
+
+    std::copy(samples, samples + writeSize1, outputRing.data() + writeStart1);
+    std::copy(samples + writeSize1, samples + writeSize1 + writeSize2, outputRing.data() + writeStart2);
+
+    ring->finishedWrite(numSamples);
+    writeSize1 = writeSize2 = 0;
+}
+
+bool AnalysisFeed::getLatestFrame(Frame& frame, uint32_t& frameNumber) const
+{
+    const juce::ScopedLock sl(frameLock);
+
+    if (latestFrameNumber == frameNumber)
+        return false;
+
+    frame = latestFrame;
+    frameNumber = latestFrameNumber;
+    return true;
+}
+
+//==============================================================================
+void AnalysisFeed::run()
+{
+    // Anything left over from before the feed was last active is stale
+    int start1, size1, start2, size2;
+    ring->prepareToRead(ring->getNumReady(), start1, size1, start2, size2);
+    ring->finishedRead(size1 + size2);
+
+    while (! threadShouldExit())
+    {
+        if (readFromRing())
+        {
+            Frame frame;
+            analyse(frame);
+
+            const juce::ScopedLock sl(frameLock);
+            latestFrame = frame;
+            ++latestFrameNumber;
+        }
+
+        wait(1000 / frameRateHz);
+    }
+}
+
+bool AnalysisFeed::readFromRing()
+{
+    int start1, size1, start2, size2;
+    ring->prepareToRead(ring->getNumReady(), start1, size1, start2, size2);
+
+    const int numRead = size1 + size2;
+    if (numRead == 0)
+        return false;
+
+    // Slides the history along and appends the new samples, keeping only
+    // the most recent fftSize
+    auto append = [&](std::vector<float>& history, const std::vector<float>& source)
+    {
+        const int numKept = juce::jmax(0, fftSize - numRead);
+        std::copy(history.end() - numKept, history.end(), history.begin());
+
+        // A read longer than the history skips its oldest samples
+        int skip = juce::jmax(0, numRead - fftSize);
+        size_t destination = static_cast<size_t>(numKept);
+
+        for (const auto& [start, size] : { std::make_pair(start1, size1), std::make_pair(start2, size2) })
+        {
+            for (int i = 0; i < size; ++i)
+            {
+                if (skip > 0)
+                    --skip;
+                else
+                    history[destination++] = source[static_cast<size_t>(start + i)];
+            }
+        }
+    };
+
+    append(inputHistory, inputRing);
+    append(outputHistory, outputRing);
+
+    ring->finishedRead(numRead);
+    return true;
+}
+
+void AnalysisFeed::analyse(Frame& frame)
+{
+    computeBands(inputHistory, frame.data());
+    computeBands(outputHistory, frame.data() + numBands);
+
+    // Transfer curve: the mean output at each input level
+    std::array<float, numCurvePoints> sums {};
+    std::array<int, numCurvePoints> counts {};
+
+    for (size_t i = 0; i < inputHistory.size(); ++i)
+    {
+        const float position = (inputHistory[i] + 1.0f) * 0.5f * static_cast<float>(numCurvePoints);
+        const auto point = static_cast<size_t>(juce::jlimit(0, numCurvePoints - 1, static_cast<int>(position)));
+
+        sums[point] += outputHistory[i];
+        ++counts[point];
+    }
+
+    uint8_t* curve = frame.data() + 2 * numBands;
+
+    for (size_t point = 0; point < static_cast<size_t>(numCurvePoints); ++point)
+    {
+        if (counts[point] == 0)
+        {
+            curve[point] = 0;
+            continue;
+        }
+
+        const float mean = juce::jlimit(-1.0f, 1.0f, sums[point] / static_cast<float>(counts[point]));
+        curve[point] = static_cast<uint8_t>(1 + juce::roundToInt((mean + 1.0f) * 0.5f * 254.0f));
+    }
+}
+
+void AnalysisFeed::computeBands(const std::vector<float>& history, uint8_t* bands)
+{
+    for (size_t i = 0; i < history.size(); ++i)
+        fftData[i] = history[i] * window[i];
+
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // Log-spaced bands from 20Hz to 20kHz (or Nyquist); each takes the
+    // loudest bin it covers. A full-scale sine through the Hann window peaks
+    // at fftSize / 4.
+    const double lowHz = 20.0;
+    const double highHz = juce::jmin(20000.0, sampleRate * 0.5);
+    const double binHz = sampleRate / fftSize;
+    const float normalise = 4.0f / static_cast<float>(fftSize);
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        const double bandLow = lowHz * std::pow(highHz / lowHz, static_cast<double>(band) / numBands);
+        const double bandHigh = lowHz * std::pow(highHz / lowHz, static_cast<double>(band + 1) / numBands);
+
+        const int firstBin = juce::jlimit(1, fftSize / 2 - 1, static_cast<int>(bandLow / binHz));
+        const int lastBin = juce::jlimit(firstBin + 1, fftSize / 2, static_cast<int>(std::ceil(bandHigh / binHz)));
+
+        float peak = 0.0f;
+        for (int bin = firstBin; bin < lastBin; ++bin)
+            peak = juce::jmax(peak, fftData[static_cast<size_t>(bin)]);
+
+        const float decibels = juce::Decibels::gainToDecibels(peak * normalise, minDecibels);
+        const float scaled = (decibels - minDecibels) / -minDecibels;
+        bands[band] = static_cast<uint8_t>(juce::jlimit(0, 255, juce::roundToInt(scaled * 255.0f)));
+    }
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Analysis feed
+    Vintage preamp coloration utility
+
+    Carries the preamp's input and output from the audio thread to the
+    editor's spectrum and transfer-curve view. The audio thread only copies
+    samples into a lock-free single-producer ring; a background thread reads
+    them, runs the FFTs and reduces everything to one small byte frame at
+    frameRateHz, which the editor sends to the page as base64.
+
+    Frame layout (frameBytes bytes):
+      [0, numBands)                  input spectrum, log-spaced bands
+      [numBands, 2 * numBands)       output spectrum
+      [2 * numBands, frameBytes)     transfer curve: mean output for each
+                                     input level from -1 to 1
+    Spectrum bytes map minDecibels..0 dB onto 0..255. Curve bytes map -1..1
+    onto 1..255, with 0 meaning no input at that level.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+
+//==============================================================================
+class AnalysisFeed : private juce::Thread
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBands = 64;
+    static constexpr int numCurvePoints = 64;
+    static constexpr int frameBytes = 2 * numBands + numCurvePoints;
+    static constexpr int frameRateHz = 30;
+    static constexpr float minDecibels = -90.0f;
+
+    using Frame = std::array<uint8_t, frameBytes>;
+
+    AnalysisFeed();
+    ~AnalysisFeed() override;
+
+    // Sizes the ring for the sample rate. Not while the audio thread pushes.
+    void prepare(double sampleRate);
+
+    // Starts or stops the analysis thread; while inactive the audio thread
+    // skips the copies altogether (message thread)
+    void setActive(bool shouldBeActive);
+
+    // Audio thread, in pairs around the preamp: the block's input before
+    // processing, then its output. Each is one copy into the ring; a block
+    // that doesn't fit is dropped.
+    void pushInput(const float* samples, int numSamples) noexcept;
+    void pushOutput(const float* samples, int numSamples) noexcept;
+
+    // Copies the newest frame if it is newer than frameNumber, which is
+    // updated (message thread)
+    bool getLatestFrame(Frame& frame, uint32_t& frameNumber) const;
+
+private:
+    void run() override;
+
+    // Appends everything in the ring to the analysis history. Returns false
+    // if there was nothing new.
+    bool readFromRing();
+
+    void analyse(Frame& frame);
+    void computeBands(const std::vector<float>& history, uint8_t* bands);
+
+    //==============================================================================
+    // Ring: input and output share one set of positions, so they stay paired
+    std::vector<float> inputRing;
+    std::vector<float> outputRing;
+    std::unique_ptr<juce::AbstractFifo> ring;
+    std::atomic<bool> active { false };
+
+    // Where the current block's input went, for its output (audio thread)
+    int writeStart1 = 0, writeSize1 = 0, writeStart2 = 0, writeSize2 = 0;
+
+    //==============================================================================
+    // Analysis thread
+    double sampleRate = 44100.0;
+    juce::dsp::FFT fft { fftOrder };
+    std::vector<float> window;
+    std::vector<float> fftData;
+    std::vector<float> inputHistory;   // The last fftSize samples
+    std::vector<float> outputHistory;
+
+    //==============================================================================
+    // Handed to the message thread
+    juce::CriticalSection frameLock;
+    Frame latestFrame {};
+    uint32_t latestFrameNumber = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisFeed)
+};
@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Capture recorder
+  ==============================================================================
+*/
+
+#include "CaptureRecorder.h"
+
+//==============================================================================
+CaptureRecorder::CaptureRecorder()
+    : juce::Thread("Dre-Dimura capture")
+{
+}
+
+CaptureRecorder::~CaptureRecorder()
+{
+    stop();
+}
+
+bool CaptureRecorder::start(const juce::File& file, const CaptureFormat::FormatRecord& format)
+{
+    stop();
+
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+
+    auto newStream = std::make_unique<juce::FileOutputStream>(file);
+    if (! newStream->openedOk())
+        return false;
+
+    CaptureFormat::FileHeader header {};
+    std::copy(std::begin(CaptureFormat::magic), std::end(CaptureFormat::magic), header.magic);
+    header.version = CaptureFormat::version;
+    header.snapshotBytes = static_cast<uint32_t>(sizeof(ParameterSnapshot));
+
+    const CaptureFormat::RecordHeader formatHeader { CaptureFormat::formatRecord, static_cast<uint32_t>(sizeof(format)) };
+
+    if (! (newStream->write(&header, sizeof(header))
+           && newStream->write(&formatHeader, sizeof(formatHeader))
+           && newStream->write(&format, sizeof(format))))
+        return false;
+
+    stream = std::move(newStream);
+
+    if (ring.empty())
+        ring.resize(static_cast<size_t>(ringBytes));
+
+    fifo.reset();
+    inBlock = false;
+    droppedBlocks = 0;
+
+    startThread(juce::Thread::Priority::background);
+    active.store(true, std::memory_order_release);
+    return true;
+}
+
+void CaptureRecorder::stop()
+{
+    if (stream == nullptr)
+        return;
+
+    active.store(false, std::memory_order_release);
+    stopThread(2000);  // Drains the ring on its way out
+
+    stream->flush();
+    juce::Logger::writeToLog("Dre-Dimura: wrote capture of " + juce::File::descriptionOfSizeInBytes(stream->getPosition())
+                             + " to " + stream->getFile().getFullPathName());
+    stream.reset();
+}
+
+juce::File CaptureRecorder::getCaptureDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("Dre-Dimura")
+        .getChildFile("Captures");
+}
+
+uint64_t CaptureRecorder::hashAudio(const juce::AudioBuffer<float>& buffer) noexcept
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        const float* samples = buffer.getReadPointer(channel);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, samples + i, sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ull;
+        }
+    }
+
+    return hash;
+}
+
+//==============================================================================
+void CaptureRecorder::prepare(const CaptureFormat::FormatRecord& format)
+{
+    // Room for the largest block the DSP was prepared for
+    staging.resize(sizeof(CaptureFormat::RecordHeader) + sizeof(CaptureFormat::BlockHeader)
+                   + sizeof(float) * format.maximumBlockSize * format.numChannels
+                   + sizeof(CaptureFormat::Segment) * maxSegments);
+    inBlock = false;
+
+    if (isActive() && ! pushRecord(CaptureFormat::formatRecord, &format, sizeof(format)))
+        ++droppedBlocks;
+}
+
+void CaptureRecorder::beginBlock(const juce::AudioBuffer<float>& input, uint32_t effectAllocations, uint32_t chainsWithMemory) noexcept
+{
+    inBlock = false;
+
+    if (! isActive())
+        return;
+
+    const auto numSamples = static_cast<size_t>(input.getNumSamples());
+    const auto numChannels = static_cast<size_t>(input.getNumChannels());
+    const auto audioOffset = sizeof(CaptureFormat::RecordHeader) + sizeof(CaptureFormat::BlockHeader);
+
+    segmentsOffset = audioOffset + sizeof(float) * numSamples * numChannels;
+
+    if (segmentsOffset + sizeof(CaptureFormat::Segment) * maxSegments > staging.size())
+    {
+        ++droppedBlocks;  // Larger than the host said it would send
+        return;
+    }
+
+    CaptureFormat::BlockHeader header {};
+    header.numSamples = static_cast<uint32_t>(numSamples);
+    header.numChannels = static_cast<uint32_t>(numChannels);
+    header.effectAllocations = effectAllocations;
+    header.chainsWithMemory = chainsWithMemory;
+    std::memcpy(staging.data() + sizeof(CaptureFormat::RecordHeader), &header, sizeof(header));
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        std::memcpy(staging.data() + audioOffset + sizeof(float) * numSamples * channel,
+                    input.getReadPointer(static_cast<int>(channel)), sizeof(float) * numSamples);
+
+    numSegments = 0;
+    inBlock = true;
+}
+
+void CaptureRecorder::addSegment(int startSample, const ParameterSnapshot& parameters) noexcept
+{
+    if (! inBlock)
+        return;
+
+    if (numSegments == maxSegments)
+    {
+        inBlock = false;  // Can't be replayed faithfully: drop it
+        ++droppedBlocks;
+        return;
+    }
+
+    const CaptureFormat::Segment segment { static_cast<uint32_t>(startSample), parameters };
+    std::memcpy(staging.data() + segmentsOffset + sizeof(segment) * numSegments, &segment, sizeof(segment));
+    ++numSegments;
+}
+
+void CaptureRecorder::endBlock(CaptureFormat::BlockMode mode, const juce::AudioBuffer<float>& output) noexcept
+{
+    if (! inBlock)
+        return;
+
+    inBlock = false;
+
+    // Finish the headers now that the block is done
+    auto* header = reinterpret_cast<CaptureFormat::BlockHeader*>(staging.data() + sizeof(CaptureFormat::RecordHeader));
+    header->mode = mode;
+    header->numSegments = numSegments;
+    header->outputHash = hashAudio(output);
+
+    const auto totalBytes = segmentsOffset + sizeof(CaptureFormat::Segment) * numSegments;
+    const CaptureFormat::RecordHeader recordHeader { CaptureFormat::blockRecord,
+                                                     static_cast<uint32_t>(totalBytes - sizeof(CaptureFormat::RecordHeader)) };
+    std::memcpy(staging.data(), &recordHeader, sizeof(recordHeader));
+
+    if (droppedBlocks > 0)
+    {
+        if (! pushRecord(CaptureFormat::gapRecord, &droppedBlocks, sizeof(droppedBlocks)))
+        {
+            ++droppedBlocks;
+            return;
+        }
+
+        droppedBlocks = 0;
+    }
+
+    if (! push(staging.data(), totalBytes))
+        ++droppedBlocks;
+}
+
+bool CaptureRecorder::push(const void* data, size_t numBytes) noexcept
+{
+    if (static_cast<size_t>(fifo.getFreeSpace()) < numBytes)
+        return false;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(static_cast<int>(numBytes), start1, size1, start2, size2);
+
+    const auto* bytes = static_cast<const char*>(data);
+    std::memcpy(ring.data() + start1, bytes, static_cast<size_t>(size1));
+    std::memcpy(ring.data() + start2, bytes + size1, static_cast<size_t>(size2));
+
+    fifo.finishedWrite(size1 + size2);
+    return true;
+}
+
+bool CaptureRecorder::pushRecord(CaptureFormat::RecordType type, const void* payload, size_t payloadBytes) noexcept
+{
+    // Header and payload go in together, or not at all
+    if (static_cast<size_t>(fifo.getFreeSpace()) < sizeof(CaptureFormat::RecordHeader) + payloadBytes)
+        return false;
+
+    const CaptureFormat::RecordHeader header { type, static_cast<uint32_t>(payloadBytes) };
+    return push(&header, sizeof(header)) && push(payload, payloadBytes);
+}
+
+//==============================================================================
+void CaptureRecorder::run()
+{
+    while (! threadShouldExit())
+    {
+        drain();
+        wait(20);
+    }
+
+    drain();
+}
+
+void CaptureRecorder::drain()
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+    stream->write(ring.data() + start1, static_cast<size_t>(size1));
+    stream->write(ring.data() + start2, static_cast<size_t>(size2));
+
+    fifo.finishedRead(size1 + size2);
+}
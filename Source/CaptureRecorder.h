@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Capture recorder
+    Vintage preamp coloration utility
+
+    Records exactly what the DSP saw, block by block, so a glitch that only
+    shows up under one particular run of automation can be replayed offline
+    under a profiler (Tools/CaptureReplay.cpp). Each block keeps its input
+    audio, the parameters it ran with (and any MIDI preset switch inside
+    it), whether it was bypassed or asleep, and a hash of its output that
+    the replay checks itself against.
+
+    The audio thread only copies into a byte ring; a background thread
+    writes the ring to disk. If the disk falls behind, blocks are dropped
+    and the gap recorded, rather than the audio thread ever waiting.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "ParameterSnapshot.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// The capture file: a FileHeader, then records, each a RecordHeader and its
+// payload. Plain structs in the writer's byte order, so a capture replays on
+// the kind of machine it was made on.
+namespace CaptureFormat
+{
+    constexpr char magic[8] = { 'D', 'D', 'C', 'A', 'P', 'T', 'U', 'R' };
+    constexpr uint32_t version = 2;
+
+    struct FileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t snapshotBytes;  // sizeof(ParameterSnapshot) in the writing build
+    };
+
+    enum RecordType : uint32_t
+    {
+        formatRecord = 1,  // FormatRecord: the DSP was prepared
+        blockRecord = 2,   // BlockHeader, input audio, Segments
+        gapRecord = 3      // uint32_t: blocks dropped here
+    };
+
+    struct RecordHeader
+    {
+        uint32_t type;
+        uint32_t size;  // Payload bytes that follow
+    };
+
+    // Everything PreampDSP::prepare() was called with
+    struct FormatRecord
+    {
+        double sampleRate;
+        uint32_t maximumBlockSize;
+        uint32_t numChannels;
+        uint32_t effectAllocations;  // See BlockHeader
+        uint32_t chainsWithMemory;   // See BlockHeader, just after preparing
+        ParameterSnapshot parameters;  // Set just before preparing
+    };
+
+    enum BlockMode : uint32_t
+    {
+        processed = 0,
+        bypassed = 1,  // PreampDSP::reset(), output is the input
+        asleep = 2     // Silence gate closed, output cleared
+    };
+
+    // Followed by the input audio, channel by channel, then numSegments Segments
+    struct BlockHeader
+    {
+        uint32_t numSamples;
+        uint32_t numChannels;
+        uint32_t mode;
+        uint32_t numSegments;
+        uint32_t effectAllocations;  // Calls to allocateRequestedEffectMemory() before this block
+        uint32_t chainsWithMemory;   // PreampDSP::getChainsWithMemory() before this block
+        uint64_t outputHash;  // CaptureRecorder::hashAudio() of the output
+    };
+
+    // From startSample on, the block ran with these parameters
+    struct Segment
+    {
+        uint32_t startSample;
+        ParameterSnapshot parameters;
+    };
+}
+
+//==============================================================================
+class CaptureRecorder : private juce::Thread
+{
+public:
+    static constexpr int ringBytes = 1 << 24;  // About 20s of stereo at 96kHz
+    static constexpr int maxSegments = 64;     // MIDI preset switches in one block
+
+    CaptureRecorder();
+    ~CaptureRecorder() override;
+
+    //==============================================================================
+    // Message thread, with processing suspended. Starting writes the file
+    // header and format; the DSP must have just been prepared with it.
+    bool start(const juce::File& file, const CaptureFormat::FormatRecord& format);
+    void stop();
+
+    bool isActive() const noexcept { return active.load(std::memory_order_acquire); }
+
+    // Where captures are written by default
+    static juce::File getCaptureDirectory();
+
+    // FNV-1a over every sample's bits: identical output, identical hash
+    static uint64_t hashAudio(const juce::AudioBuffer<float>& buffer) noexcept;
+
+    //==============================================================================
+    // prepareToPlay: sizes the block staging area (always) and, while
+    // capturing, records the new format
+    void prepare(const CaptureFormat::FormatRecord& format);
+
+    // Audio thread, once per block while capturing: the input before any
+    // processing, each parameter change at its sample, then how the block
+    // ended and its output. Blocks that don't fit are dropped.
+    void beginBlock(const juce::AudioBuffer<float>& input, uint32_t effectAllocations, uint32_t chainsWithMemory) noexcept;
+    void addSegment(int startSample, const ParameterSnapshot& parameters) noexcept;
+    void endBlock(CaptureFormat::BlockMode mode, const juce::AudioBuffer<float>& output) noexcept;
+
+private:
+    //==============================================================================
+    bool push(const void* data, size_t numBytes) noexcept;
+    bool pushRecord(CaptureFormat::RecordType type, const void* payload, size_t payloadBytes) noexcept;
+
+    void run() override;
+    void drain();
+
+    std::atomic<bool> active { false };
+
+    // Producer side (audio thread, or prepareToPlay)
+    std::vector<char> staging;  // RecordHeader, BlockHeader, audio, segments
+    size_t stagedBytes = 0;
+    size_t segmentsOffset = 0;
+    uint32_t numSegments = 0;
+    bool inBlock = false;
+    uint32_t droppedBlocks = 0;  // Recorded as a gap before the next block that fits
+
+    // Shared ring and its consumer (background thread)
+    std::vector<char> ring;
+    juce::AbstractFifo fifo { ringBytes };
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CaptureRecorder)
+};
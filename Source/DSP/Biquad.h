@@ -0,0 +1,58 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+
+/**
+ * StereoBiquad - Second-order IIR section for a stereo pair
+ *
+ * One set of coefficients and both channels' state stored inline, so a
+ * filter is a plain 36-byte value living next to the rest of its effect's
+ * state instead of a ref-counted coefficient object plus a separately
+ * allocated state block per channel (as with juce::dsp::IIR::Filter).
+ *
+ * Coefficients come from juce::dsp::IIR::ArrayCoefficients, so the filter
+ * designs are unchanged. Transposed direct form II, same as IIR::Filter.
+ */
+struct StereoBiquad
+{
+    // b0, b1, b2, a1, a2 (normalised by a0)
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+
+    // Per-channel state
+    float s1L = 0.0f, s2L = 0.0f;
+    float s1R = 0.0f, s2R = 0.0f;
+
+    // Takes {b0, b1, b2, a0, a1, a2} as returned by IIR::ArrayCoefficients
+    void setCoefficients(const std::array<float, 6>& c) noexcept
+    {
+        const float a0Inv = 1.0f / c[3];
+        b0 = c[0] * a0Inv;
+        b1 = c[1] * a0Inv;
+        b2 = c[2] * a0Inv;
+        a1 = c[4] * a0Inv;
+        a2 = c[5] * a0Inv;
+    }
+
+    void reset() noexcept
+    {
+        s1L = s2L = s1R = s2R = 0.0f;
+    }
+
+    float processLeft(float x) noexcept { return tick(x, s1L, s2L); }
+    float processRight(float x) noexcept { return tick(x, s1R, s2R); }
+
+    float processSample(size_t channel, float x) noexcept
+    {
+        return channel == 0 ? processLeft(x) : processRight(x);
+    }
+
+private:
+    float tick(float x, float& s1, float& s2) const noexcept
+    {
+        const float y = b0 * x + s1;
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+        return y;
+    }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Biquad.h"
+
+/**
+ * BiquadCascade - A fixed chain of StereoBiquad sections run as one loop
+ *
+ * For static EQ that sits after a stage a whole block at a time. Each
+ * sample goes through every section for both channels before moving on,
+ * and the sections are copied into locals for the duration of the block:
+ * the samples and the filter state are both floats, so state kept in the
+ * object would have to be reloaded after every store to the buffer. With
+ * NumSections known at compile time the inner loop unrolls and all the
+ * coefficients and state stay in registers.
+ *
+ * Sections are kept second-order rather than multiplied out into a single
+ * higher-order direct form: the low shelves and the 10Hz DC blocker have
+ * poles close to z = 1, which a float higher-order form can't place
+ * accurately (or even keep stable) at high sample rates.
+ */
+template <size_t NumSections>
+struct BiquadCascade
+{
+    std::array<StereoBiquad, NumSections> sections;
+
+    StereoBiquad& operator[](size_t index) noexcept { return sections[index]; }
+
+    void reset() noexcept
+    {
+        for (auto& section : sections)
+            section.reset();
+    }
+
+    // Filters a block in place. rightChannel may be null for mono.
+    void process(float* leftChannel, float* rightChannel, int numSamples) noexcept
+    {
+        auto local = sections;
+
+        if (rightChannel == nullptr)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float left = leftChannel[i];
+
+                for (auto& section : local)
+                    left = section.processLeft(left);
+
+                leftChannel[i] = left;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float left = leftChannel[i];
+                float right = rightChannel[i];
+
+                for (auto& section : local)
+                {
+                    left = section.processLeft(left);
+                    right = section.processRight(right);
+                }
+
+                leftChannel[i] = left;
+                rightChannel[i] = right;
+            }
+        }
+
+        sections = local;
+    }
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+
+/**
+ * DeadlineMonitor - How close processBlock runs to the real-time deadline
+ *
+ * Each block's wall-clock duration is recorded as a percentage of its
+ * budget (numSamples / sampleRate) into a 1%-wide histogram, from which the
+ * worst case, p99 and the number of blocks over 50/80/100% are read.
+ *
+ * The audio thread is the only writer (plain atomic load/store); reset()
+ * only raises a flag, and the audio thread clears the counters at its next
+ * block, so readers and the reset never race the writer.
+ */
+class DeadlineMonitor
+{
+public:
+    static constexpr int maxPercent = 200;  // The last bucket holds everything from here up
+
+    struct Stats
+    {
+        uint64_t blocks = 0;
+        double meanPercent = 0.0;
+        double worstPercent = 0.0;
+        int p99Percent = 0;  // Upper edge of the bucket holding the 99th percentile
+        uint64_t over50 = 0;
+        uint64_t over80 = 0;
+        uint64_t over100 = 0;  // Missed deadlines: would have dropped out on their own
+
+        // Predicted to drop out under a little more load: the 99th percentile
+        // is already past 80% of the budget, or a deadline has been missed
+        bool isXrunRisk() const noexcept { return p99Percent > 80 || over100 > 0; }
+    };
+
+    void prepare(double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    // Any thread
+    void reset() noexcept { resetRequested.store(true, std::memory_order_release); }
+
+    // Audio thread, once per processBlock
+    void record(double elapsedSeconds, int numSamples) noexcept
+    {
+        if (resetRequested.exchange(false, std::memory_order_acquire))
+            clear();
+
+        if (numSamples <= 0)
+            return;
+
+        const double percent = 100.0 * elapsedSeconds * sampleRate / numSamples;
+        const auto bucket = static_cast<size_t>(juce::jlimit(0, maxPercent, static_cast<int>(percent)));
+
+        increment(histogram[bucket]);
+        increment(blocks);
+        totalPercent.store(totalPercent.load(std::memory_order_relaxed) + percent, std::memory_order_relaxed);
+
+        if (percent > worstPercent.load(std::memory_order_relaxed))
+            worstPercent.store(percent, std::memory_order_relaxed);
+
+        if (percent > 50.0)  increment(over50);
+        if (percent > 80.0)  increment(over80);
+        if (percent > 100.0) increment(over100);
+    }
+
+    // Missed deadlines so far (any thread)
+    uint64_t getMissCount() const noexcept { return over100.load(std::memory_order_relaxed); }
+
+    // Any thread
+    Stats getStats() const
+    {
+        Stats stats;
+        stats.blocks = blocks.load(std::memory_order_relaxed);
+        stats.worstPercent = worstPercent.load(std::memory_order_relaxed);
+        stats.over50 = over50.load(std::memory_order_relaxed);
+        stats.over80 = over80.load(std::memory_order_relaxed);
+        stats.over100 = over100.load(std::memory_order_relaxed);
+
+        if (stats.blocks == 0)
+            return stats;
+
+        stats.meanPercent = totalPercent.load(std::memory_order_relaxed) / static_cast<double>(stats.blocks);
+
+        // Walk down from the top until 1% of the blocks are above
+        const auto tail = stats.blocks / 100;
+        uint64_t above = 0;
+
+        for (int bucket = maxPercent; bucket >= 0; --bucket)
+        {
+            above += histogram[static_cast<size_t>(bucket)].load(std::memory_order_relaxed);
+
+            if (above > tail)
+            {
+                stats.p99Percent = bucket + 1;
+                break;
+            }
+        }
+
+        return stats;
+    }
+
+    static juce::String toString(const Stats& stats)
+    {
+        return juce::String(stats.blocks) + " blocks, mean " + juce::String(stats.meanPercent, 1)
+             + "%, p99 " + juce::String(stats.p99Percent) + "%, worst " + juce::String(stats.worstPercent, 1)
+             + "% of budget; over 50/80/100%: " + juce::String(stats.over50) + "/" + juce::String(stats.over80)
+             + "/" + juce::String(stats.over100) + (stats.isXrunRisk() ? " - XRUN RISK" : "");
+    }
+
+    /** Records the enclosing processBlock's duration */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(DeadlineMonitor& monitorToUse, int blockSamples) noexcept
+            : monitor(monitorToUse), numSamples(blockSamples), start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~ScopedTimer()
+        {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            monitor.record(elapsed.count(), numSamples);
+        }
+
+    private:
+        DeadlineMonitor& monitor;
+        const int numSamples;
+        const std::chrono::steady_clock::time_point start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedTimer)
+    };
+
+private:
+    template <typename T>
+    static void increment(std::atomic<T>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void clear() noexcept
+    {
+        for (auto& bucket : histogram)
+            bucket.store(0, std::memory_order_relaxed);
+
+        blocks.store(0, std::memory_order_relaxed);
+        totalPercent.store(0.0, std::memory_order_relaxed);
+        worstPercent.store(0.0, std::memory_order_relaxed);
+        over50.store(0, std::memory_order_relaxed);
+        over80.store(0, std::memory_order_relaxed);
+        over100.store(0, std::memory_order_relaxed);
+    }
+
+    double sampleRate = 44100.0;
+    std::atomic<bool> resetRequested { false };
+
+    std::array<std::atomic<uint64_t>, maxPercent + 1> histogram {};
+    std::atomic<uint64_t> blocks { 0 };
+    std::atomic<double> totalPercent { 0.0 };
+    std::atomic<double> worstPercent { 0.0 };
+    std::atomic<uint64_t> over50 { 0 };
+    std::atomic<uint64_t> over80 { 0 };
+    std::atomic<uint64_t> over100 { 0 };
+};
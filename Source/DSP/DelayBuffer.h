@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+
+/**
+ * StereoFrame - One left/right sample pair of a delay line
+ *
+ * Aligned to its own size so a frame is always read and written as a single
+ * 8-byte load/store, and never straddles a cache line.
+ */
+struct alignas(8) StereoFrame
+{
+    float left;
+    float right;
+};
+
+inline StereoFrame operator+(StereoFrame a, StereoFrame b) noexcept { return { a.left + b.left, a.right + b.right }; }
+inline StereoFrame operator-(StereoFrame a, StereoFrame b) noexcept { return { a.left - b.left, a.right - b.right }; }
+inline StereoFrame operator*(StereoFrame a, float gain) noexcept { return { a.left * gain, a.right * gain }; }
+
+/**
+ * DelayBuffer - Non-owning view of a stereo delay line living in a DspArena
+ *
+ * Left and right are stored interleaved, one StereoFrame per sample, so a
+ * tap touches one cache line instead of one per channel. Effects that need
+ * two lines of different lengths keep two DelayBuffers.
+ *
+ * An effect sets the length it needs in prepare(); the memory itself is
+ * attached separately, once the effect is actually used.
+ */
+struct DelayBuffer
+{
+    static constexpr int floatsPerFrame = 2;
+
+    StereoFrame* data = nullptr;
+    int length = 0;          // Frames used at the current sample rate
+    int reservedLength = 0;  // Frames reserved so any re-prepare up to the max rate fits
+
+    StereoFrame& operator[](int index) noexcept { return data[index]; }
+    StereoFrame operator[](int index) const noexcept { return data[index]; }
+    int size() const noexcept { return length; }
+
+    void clear() noexcept
+    {
+        if (data != nullptr)
+            std::fill(data, data + length, StereoFrame {});
+    }
+};
@@ -0,0 +1,78 @@
+#include "DspArena.h"
+
+void DspArena::Chunk::allocate(size_t numBytes)
+{
+    // Over-allocate by one alignment step so the start can be snapped to it
+    memory.free();
+    memory.malloc(numBytes + alignment);
+
+    auto address = reinterpret_cast<uintptr_t>(memory.get());
+    auto aligned = (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    start = memory.get() + (aligned - address);
+    capacity = numBytes;
+    used = 0;
+}
+
+void* DspArena::Chunk::take(size_t numBytes)
+{
+    if (start == nullptr || used + numBytes > capacity)
+        return nullptr;
+
+    auto* result = start + used;
+    used += numBytes;
+    return result;
+}
+
+void DspArena::prepare(size_t numBytes)
+{
+    overflowChunks.clear();
+
+    if (numBytes > mainChunk.capacity)
+        mainChunk.allocate(numBytes);
+    else
+        mainChunk.used = 0;
+}
+
+float* DspArena::allocateFloats(size_t numFloats)
+{
+    const auto numBytes = getAllocationSize(numFloats);
+
+    auto* result = mainChunk.take(numBytes);
+
+    if (result == nullptr && ! overflowChunks.empty())
+        result = overflowChunks.back()->take(numBytes);
+
+    if (result == nullptr)
+    {
+        // Grow in reasonably large steps so waking effects one by one
+        // doesn't produce a chunk per effect
+        auto chunk = std::make_unique<Chunk>();
+        chunk->allocate(juce::jmax(numBytes, static_cast<size_t>(64 * 1024)));
+        result = chunk->take(numBytes);
+        overflowChunks.push_back(std::move(chunk));
+    }
+
+    std::memset(result, 0, numBytes);
+    return static_cast<float*>(result);
+}
+
+size_t DspArena::getAllocationSize(size_t numFloats)
+{
+    return (numFloats * sizeof(float) + alignment - 1) & ~(alignment - 1);
+}
+
+size_t DspArena::getBytesReserved() const
+{
+    auto total = mainChunk.capacity;
+    for (auto& chunk : overflowChunks)
+        total += chunk->capacity;
+    return total;
+}
+
+size_t DspArena::getBytesUsed() const
+{
+    auto total = mainChunk.used;
+    for (auto& chunk : overflowChunks)
+        total += chunk->used;
+    return total;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <memory>
+#include <vector>
+
+/**
+ * DspArena - Per-instance bump allocator for DSP memory
+ *
+ * Each PreampDSP owns one arena. prepare() sizes a single contiguous,
+ * cache-line aligned block for everything needed at that point, so the
+ * working set of an instance stays together instead of being scattered
+ * across the heap. Memory requested after prepare (a preamp selected for
+ * the first time) is served from the remaining space, or from an overflow
+ * chunk that the next prepare() folds back into the main block.
+ *
+ * Not thread-safe: only ever called from prepare or the message thread.
+ * The audio thread just uses the pointers it hands out.
+ */
+class DspArena
+{
+public:
+    static constexpr size_t alignment = 64;  // One cache line
+
+    DspArena() = default;
+
+    // Drops every allocation and makes sure the main block can hold at least
+    // numBytes. Only reallocates when the existing block is too small.
+    void prepare(size_t numBytes);
+
+    // Returns zeroed, cache-line aligned memory for numFloats floats
+    float* allocateFloats(size_t numFloats);
+
+    // Bytes a request for numFloats floats actually consumes (incl. alignment)
+    static size_t getAllocationSize(size_t numFloats);
+
+    size_t getBytesReserved() const;
+    size_t getBytesUsed() const;
+
+private:
+    struct Chunk
+    {
+        juce::HeapBlock<char> memory;
+        char* start = nullptr;  // First aligned byte in memory
+        size_t capacity = 0;
+        size_t used = 0;
+
+        void allocate(size_t numBytes);
+        void* take(size_t numBytes);
+    };
+
+    Chunk mainChunk;
+    std::vector<std::unique_ptr<Chunk>> overflowChunks;
+
+    JUCE_DECLARE_NON_COPYABLE(DspArena)
+};
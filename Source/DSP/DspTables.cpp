@@ -0,0 +1,84 @@
+#include "DspTables.h"
+
+DspTables::DspTables()
+{
+    request(DspTableType::Tanh);
+    request(DspTableType::Sine);
+}
+
+const DspTables::Table* DspTables::get(DspTableType type, double sampleRate) const noexcept
+{
+    const int count = numEntries.load(std::memory_order_acquire);
+
+    for (int i = 0; i < count; ++i)
+    {
+        const auto& entry = entries[static_cast<size_t>(i)];
+
+        if (entry.type == type && entry.sampleRate == sampleRate)
+            return entry.table.load(std::memory_order_acquire);
+    }
+
+    return nullptr;
+}
+
+void DspTables::request(DspTableType type, double sampleRate)
+{
+    const juce::ScopedLock sl(requestLock);
+
+    const int count = numEntries.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < count; ++i)
+    {
+        const auto& entry = entries[static_cast<size_t>(i)];
+
+        if (entry.type == type && entry.sampleRate == sampleRate)
+            return;
+    }
+
+    if (count == maxEntries)
+    {
+        jassertfalse;  // Raise maxEntries; callers fall back to direct computation meanwhile
+        return;
+    }
+
+    // Built before the entry is counted, so get() never finds it half done
+    auto& entry = entries[static_cast<size_t>(count)];
+    entry.type = type;
+    entry.sampleRate = sampleRate;
+    entry.storage = build(type, sampleRate);
+    entry.table.store(entry.storage.get(), std::memory_order_release);
+    numEntries.store(count + 1, std::memory_order_release);
+}
+
+std::unique_ptr<DspTables::Table> DspTables::build(DspTableType type, double sampleRate)
+{
+    auto table = std::make_unique<Table>();
+
+    switch (type)
+    {
+        case DspTableType::Tanh:
+            // Linear interpolation error below 4e-7
+            table->initialise([](float x) { return std::tanh(x); }, -tanhRange, tanhRange, 8192);
+            break;
+
+        case DspTableType::Sine:
+            // Linear interpolation error below 3e-7
+            table->initialise([](float x) { return std::sin(x * juce::MathConstants<float>::twoPi); }, 0.0f, 1.0f, 4097);
+            break;
+
+        case DspTableType::CutoffGain:
+        {
+            // Relative error below 5e-5, worst right at the top of the range
+            jassert(sampleRate > 0.0);
+            const auto maxFrequency = static_cast<float>(maxCutoffRatio * sampleRate);
+            table->initialise([sampleRate](float f)
+                              {
+                                  return static_cast<float>(std::tan(juce::MathConstants<double>::pi * f / sampleRate));
+                              },
+                              0.0f, maxFrequency, 4096);
+            break;
+        }
+    }
+
+    return table;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+/**
+ * DspTables - Read-only lookup tables shared by every plugin instance
+ *
+ * Hold one through juce::SharedResourcePointer<DspTables>: the first
+ * instance in the process creates the cache, later ones share it, and it is
+ * freed with the last one, so memory and setup cost stay flat however many
+ * instances a session runs.
+ *
+ * Tables are keyed by type and sample rate (0 for tables that don't depend
+ * on it) and built by request(), on the calling thread, before it returns:
+ * once prepare() has asked for a table, every block after it reads the
+ * same table, so the output doesn't depend on timing. A table that was
+ * never requested reads as null and callers compute the function directly.
+ * Once published a table is immutable.
+ */
+
+enum class DspTableType
+{
+    Tanh,      // tanh(x) over [-tanhRange, tanhRange], clamped outside
+    Sine,      // sin(2 pi x) over one cycle, x in cycles
+    CutoffGain // tan(pi f / sampleRate) for f in Hz up to 0.49 sampleRate (per rate)
+};
+
+class DspTables
+{
+public:
+    using Table = juce::dsp::LookupTableTransform<float>;
+
+    static constexpr float tanhRange = 8.0f;  // tanh(8) is within 3e-7 of 1
+    static constexpr double maxCutoffRatio = 0.49;  // Of the sample rate
+
+    DspTables();  // Builds the rate-independent tables
+
+    // Lock-free, safe on the audio thread. Null if the table was never requested.
+    const Table* get(DspTableType type, double sampleRate = 0.0) const noexcept;
+
+    // Builds a table if it isn't cached yet, and returns once it can be read
+    // through get(). Message thread (e.g. from prepareToPlay): a build takes
+    // well under a millisecond, but it allocates.
+    void request(DspTableType type, double sampleRate = 0.0);
+
+private:
+    struct Entry
+    {
+        DspTableType type = DspTableType::Tanh;
+        double sampleRate = 0.0;
+        std::unique_ptr<Table> storage;               // Written under requestLock only
+        std::atomic<const Table*> table { nullptr };  // Published once storage is complete
+    };
+
+    static std::unique_ptr<Table> build(DspTableType type, double sampleRate);
+
+    // Fixed capacity, so entries never move while the audio thread reads them
+    static constexpr int maxEntries = 16;
+    std::array<Entry, maxEntries> entries;
+    std::atomic<int> numEntries { 0 };
+
+    juce::CriticalSection requestLock;
+
+    JUCE_DECLARE_NON_COPYABLE(DspTables)
+};
+
+// ======================================
+// Lookups, falling back to the exact function while the table is missing
+// ======================================
+
+inline float tanhLookup(const DspTables::Table* table, float x) noexcept
+{
+    return table != nullptr ? table->processSample(x) : std::tanh(x);
+}
+
+// sin(2 pi * phase), phase in cycles (any value; wrapped into [0, 1))
+inline float sineLookup(const DspTables::Table* table, float phase) noexcept
+{
+    if (table == nullptr)
+        return std::sin(phase * juce::MathConstants<float>::twoPi);
+
+    return table->processSampleUnchecked(phase - std::floor(phase));
+}
+
+// The SVF's prewarped cutoff gain, tan(pi * frequency / sampleRate). The
+// table must be the CutoffGain one for this sampleRate.
+inline float cutoffGainLookup(const DspTables::Table* table, float frequency, double sampleRate) noexcept
+{
+    if (table == nullptr)
+        return static_cast<float>(std::tan(juce::MathConstants<double>::pi
+                                           * juce::jmin(static_cast<double>(frequency), DspTables::maxCutoffRatio * sampleRate)
+                                           / sampleRate));
+
+    return table->processSample(frequency);
+}
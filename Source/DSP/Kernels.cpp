@@ -0,0 +1,187 @@
+#include "Kernels.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+
+// =============================================================================
+// Scalar reference
+// =============================================================================
+
+namespace
+{
+    // ======================================
+    // FILAMENT: Cold digital precision
+    // ======================================
+    // Character: Clean, precise, crystalline. Odd harmonics (3rd, 5th).
+    // Symmetric clipping, fast transient response.
+    // Mathematical precision, no warmth.
+    void filamentShapeScalar(const float* input, const float* driveValues, float* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float drive = driveValues[i];
+
+            // Linear input gain (no coloration)
+            float gained = input[i] * (1.0f + drive * 3.0f);
+
+            // Symmetric waveshaping with odd harmonics
+            // Chebyshev-style polynomial for clean odd harmonics
+            float x = gained;
+            float x2 = x * x;
+            float x3 = x2 * x;
+            float x5 = x3 * x2;
+
+            // Odd harmonic series: fundamental + 3rd + 5th
+            float shaped = x - (x3 * 0.2f * drive) + (x5 * 0.05f * drive);
+
+            // Hard limiter with slight knee (digital precision)
+            float threshold = 1.0f - drive * 0.3f;  // Lower threshold at high drive
+            if (std::abs(shaped) > threshold)
+            {
+                float excess = std::abs(shaped) - threshold;
+                float knee = threshold + excess * 0.3f;  // Slight softening at limit
+                shaped = (shaped > 0 ? 1.0f : -1.0f) * std::min(knee, 1.0f);
+            }
+
+            // No slew limiting - instant transient response
+
+            output[i] = shaped * 0.85f;
+        }
+    }
+
+    void multiplyScalar(float* data, const float* gains, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] *= gains[i];
+    }
+
+    float peakMagnitudeScalar(const float* data, int numSamples)
+    {
+        float peak = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            peak = std::max(peak, std::abs(data[i]));
+        return peak;
+    }
+}
+
+const DspKernels KernelVariants::scalar { KernelIsa::Scalar, "scalar", filamentShapeScalar, multiplyScalar, peakMagnitudeScalar };
+
+// =============================================================================
+// Selection
+// =============================================================================
+
+namespace
+{
+    const DspKernels* getVariant(KernelIsa isa)
+    {
+        switch (isa)
+        {
+            case KernelIsa::Scalar: return &KernelVariants::scalar;
+            case KernelIsa::SSE2:   return KernelVariants::sse2();
+            case KernelIsa::AVX2:   return KernelVariants::avx2();
+            case KernelIsa::AVX512: return KernelVariants::avx512();
+        }
+        return nullptr;
+    }
+
+    bool isSupported(KernelIsa isa)
+    {
+        if (getVariant(isa) == nullptr)
+            return false;
+
+        switch (isa)
+        {
+            case KernelIsa::Scalar: return true;
+            case KernelIsa::SSE2:   return juce::SystemStats::hasSSE2();
+            case KernelIsa::AVX2:   return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+            case KernelIsa::AVX512: return juce::SystemStats::hasAVX512F();
+        }
+        return false;
+    }
+
+   #if JUCE_DEBUG
+    // Compares a variant against the scalar reference on a fixed test signal
+    void validateAgainstScalar(const DspKernels& kernels)
+    {
+        constexpr int numSamples = 67;  // Odd, so every tail loop runs too
+        float input[numSamples], drive[numSamples], expected[numSamples], actual[numSamples];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            input[i] = std::sin(static_cast<float>(i) * 0.37f) * (0.2f + static_cast<float>(i) * 0.03f);
+            drive[i] = static_cast<float>(i % 11) / 10.0f;
+        }
+
+        KernelVariants::scalar.filamentShape(input, drive, expected, numSamples);
+        kernels.filamentShape(input, drive, actual, numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            jassert(std::abs(expected[i] - actual[i]) < 1.0e-5f);
+
+        std::copy(input, input + numSamples, expected);
+        std::copy(input, input + numSamples, actual);
+        KernelVariants::scalar.multiply(expected, drive, numSamples);
+        kernels.multiply(actual, drive, numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            jassert(expected[i] == actual[i]);
+
+        jassert(KernelVariants::scalar.peakMagnitude(input, numSamples) == kernels.peakMagnitude(input, numSamples));
+    }
+   #endif
+
+    KernelIsa getRequestedIsa()
+    {
+        // Environment override for testing, e.g. DRE_DIMURA_KERNELS=scalar
+        const juce::String requested (std::getenv("DRE_DIMURA_KERNELS"));
+
+        if (requested.equalsIgnoreCase("scalar")) return KernelIsa::Scalar;
+        if (requested.equalsIgnoreCase("sse2"))   return KernelIsa::SSE2;
+        if (requested.equalsIgnoreCase("avx2"))   return KernelIsa::AVX2;
+        if (requested.equalsIgnoreCase("avx512")) return KernelIsa::AVX512;
+
+        return getBestSupportedKernelIsa();
+    }
+
+    std::atomic<const DspKernels*> selectedKernels { nullptr };
+
+    const DspKernels* select(KernelIsa isa)
+    {
+        if (! isSupported(isa))
+            isa = getBestSupportedKernelIsa();
+
+        auto* kernels = getVariant(isa);
+
+       #if JUCE_DEBUG
+        validateAgainstScalar(*kernels);
+       #endif
+
+        return kernels;
+    }
+}
+
+KernelIsa getBestSupportedKernelIsa()
+{
+    for (auto isa : { KernelIsa::AVX512, KernelIsa::AVX2, KernelIsa::SSE2 })
+        if (isSupported(isa))
+            return isa;
+
+    return KernelIsa::Scalar;
+}
+
+const DspKernels& getDspKernels()
+{
+    auto* kernels = selectedKernels.load(std::memory_order_acquire);
+
+    if (kernels == nullptr)
+    {
+        // Selecting twice on a race is harmless: both pick the same table
+        kernels = select(getRequestedIsa());
+        selectedKernels.store(kernels, std::memory_order_release);
+    }
+
+    return *kernels;
+}
+
+void forceDspKernels(KernelIsa isa)
+{
+    selectedKernels.store(select(isa), std::memory_order_release);
+}
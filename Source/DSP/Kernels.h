@@ -0,0 +1,83 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/**
+ * Kernels - Hot DSP loops built for several instruction sets
+ *
+ * The plugin itself is compiled for the baseline x86-64 target, so these
+ * loops are additionally built for SSE2, AVX2 (+FMA) and AVX-512 in their
+ * own translation units (using per-function target attributes, so universal
+ * macOS builds still compile). The best variant the CPU supports is chosen
+ * once, on first use, through juce::SystemStats (CPUID).
+ *
+ * Only loops that are data-parallel across samples live here. Recursive
+ * filters, the stateful Cathode/Steel Plate shapers and the delay lines
+ * carry state from one sample to the next and stay scalar (across
+ * independent streams they are data-parallel: see PreampBatch).
+ *
+ * The scalar variant is the reference: in debug builds every other variant
+ * is checked against it when selected. Set DRE_DIMURA_KERNELS to scalar,
+ * sse2, avx2 or avx512 (or call forceDspKernels) to pin a variant for
+ * testing.
+ */
+
+enum class KernelIsa
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+struct DspKernels
+{
+    KernelIsa isa;
+    const char* name;
+
+    // Filament preamp shaper: odd-harmonic polynomial into a soft-kneed
+    // hard limit, with a per-sample drive. In place is fine.
+    void (*filamentShape)(const float* input, const float* drive, float* output, int numSamples);
+
+    // data[i] *= gains[i]
+    void (*multiply)(float* data, const float* gains, int numSamples);
+
+    // Largest absolute sample value
+    float (*peakMagnitude)(const float* data, int numSamples);
+};
+
+// The selected variant (chosen on first call, thread-safe). The first call
+// does the selection, so make it from prepare, not the audio thread.
+const DspKernels& getDspKernels();
+
+// Best variant this CPU supports
+KernelIsa getBestSupportedKernelIsa();
+
+// Pins a variant, e.g. for A/B testing. Falls back to the best supported one
+// if the CPU lacks the requested instruction set. Not for the audio thread.
+void forceDspKernels(KernelIsa isa);
+
+// Variant tables, defined in their own translation units. Null when the
+// variant isn't built for this architecture.
+namespace KernelVariants
+{
+    extern const DspKernels scalar;
+    const DspKernels* sse2();
+    const DspKernels* avx2();
+    const DspKernels* avx512();
+}
+
+// -----------------------------------------------------------------------------
+// Shared by the variant translation units
+
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)) && ! defined(DRE_DIMURA_NO_SIMD_KERNELS)
+ #define DRE_DIMURA_X86_KERNELS 1
+#else
+ #define DRE_DIMURA_X86_KERNELS 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+ #define DRE_DIMURA_TARGET(isa) __attribute__((target(isa)))
+#else
+ #define DRE_DIMURA_TARGET(isa)  // MSVC allows any intrinsic without flags
+#endif
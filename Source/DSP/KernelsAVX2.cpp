@@ -0,0 +1,81 @@
+#include "Kernels.h"
+
+#if DRE_DIMURA_X86_KERNELS
+#include <immintrin.h>
+
+// =============================================================================
+// AVX2 + FMA variant (8 lanes). See the scalar reference in Kernels.cpp.
+// =============================================================================
+
+namespace
+{
+    DRE_DIMURA_TARGET("avx2,fma")
+    void filamentShapeAVX2(const float* input, const float* driveValues, float* output, int numSamples)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const __m256 drive = _mm256_loadu_ps(driveValues + i);
+
+            // Input gain, then the odd harmonic series
+            const __m256 x = _mm256_mul_ps(_mm256_loadu_ps(input + i), _mm256_fmadd_ps(drive, _mm256_set1_ps(3.0f), one));
+            const __m256 x2 = _mm256_mul_ps(x, x);
+            const __m256 x3 = _mm256_mul_ps(x2, x);
+            const __m256 x5 = _mm256_mul_ps(x3, x2);
+
+            __m256 shaped = _mm256_fnmadd_ps(_mm256_mul_ps(x3, _mm256_set1_ps(0.2f)), drive, x);
+            shaped = _mm256_fmadd_ps(_mm256_mul_ps(x5, _mm256_set1_ps(0.05f)), drive, shaped);
+
+            // Soft-kneed limit where |shaped| exceeds the threshold
+            const __m256 threshold = _mm256_fnmadd_ps(drive, _mm256_set1_ps(0.3f), one);
+            const __m256 magnitude = _mm256_andnot_ps(signMask, shaped);
+            const __m256 knee = _mm256_min_ps(_mm256_fmadd_ps(_mm256_sub_ps(magnitude, threshold), _mm256_set1_ps(0.3f), threshold), one);
+            const __m256 limited = _mm256_or_ps(_mm256_and_ps(shaped, signMask), knee);
+
+            shaped = _mm256_blendv_ps(shaped, limited, _mm256_cmp_ps(magnitude, threshold, _CMP_GT_OQ));
+            _mm256_storeu_ps(output + i, _mm256_mul_ps(shaped, _mm256_set1_ps(0.85f)));
+        }
+
+        KernelVariants::scalar.filamentShape(input + i, driveValues + i, output + i, numSamples - i);
+    }
+
+    DRE_DIMURA_TARGET("avx2,fma")
+    void multiplyAVX2(float* data, const float* gains, int numSamples)
+    {
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8)
+            _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), _mm256_loadu_ps(gains + i)));
+
+        KernelVariants::scalar.multiply(data + i, gains + i, numSamples - i);
+    }
+
+    DRE_DIMURA_TARGET("avx2,fma")
+    float peakMagnitudeAVX2(const float* data, int numSamples)
+    {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        __m256 peak = _mm256_setzero_ps();
+
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8)
+            peak = _mm256_max_ps(peak, _mm256_andnot_ps(signMask, _mm256_loadu_ps(data + i)));
+
+        __m128 half = _mm_max_ps(_mm256_castps256_ps128(peak), _mm256_extractf128_ps(peak, 1));
+        half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_max_ss(half, _mm_shuffle_ps(half, half, 1));
+
+        return juce::jmax(_mm_cvtss_f32(half), KernelVariants::scalar.peakMagnitude(data + i, numSamples - i));
+    }
+
+    const DspKernels avx2Kernels { KernelIsa::AVX2, "avx2", filamentShapeAVX2, multiplyAVX2, peakMagnitudeAVX2 };
+}
+
+const DspKernels* KernelVariants::avx2() { return &avx2Kernels; }
+
+#else
+
+const DspKernels* KernelVariants::avx2() { return nullptr; }
+
+#endif
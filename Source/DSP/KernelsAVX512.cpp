@@ -0,0 +1,82 @@
+#include "Kernels.h"
+
+#if DRE_DIMURA_X86_KERNELS
+#include <immintrin.h>
+
+// =============================================================================
+// AVX-512F variant (16 lanes, masked tails). See the scalar reference in
+// Kernels.cpp.
+// =============================================================================
+
+namespace
+{
+    inline __mmask16 tailMask(int remaining)
+    {
+        return static_cast<__mmask16>(remaining >= 16 ? 0xffff : (1u << remaining) - 1u);
+    }
+
+    DRE_DIMURA_TARGET("avx512f")
+    void filamentShapeAVX512(const float* input, const float* driveValues, float* output, int numSamples)
+    {
+        const __m512 one = _mm512_set1_ps(1.0f);
+        const __m512 zero = _mm512_setzero_ps();
+
+        for (int i = 0; i < numSamples; i += 16)
+        {
+            const __mmask16 lanes = tailMask(numSamples - i);
+            const __m512 drive = _mm512_maskz_loadu_ps(lanes, driveValues + i);
+
+            // Input gain, then the odd harmonic series
+            const __m512 x = _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, input + i), _mm512_fmadd_ps(drive, _mm512_set1_ps(3.0f), one));
+            const __m512 x2 = _mm512_mul_ps(x, x);
+            const __m512 x3 = _mm512_mul_ps(x2, x);
+            const __m512 x5 = _mm512_mul_ps(x3, x2);
+
+            __m512 shaped = _mm512_fnmadd_ps(_mm512_mul_ps(x3, _mm512_set1_ps(0.2f)), drive, x);
+            shaped = _mm512_fmadd_ps(_mm512_mul_ps(x5, _mm512_set1_ps(0.05f)), drive, shaped);
+
+            // Soft-kneed limit where |shaped| exceeds the threshold
+            const __m512 threshold = _mm512_fnmadd_ps(drive, _mm512_set1_ps(0.3f), one);
+            const __m512 magnitude = _mm512_abs_ps(shaped);
+            const __m512 knee = _mm512_min_ps(_mm512_fmadd_ps(_mm512_sub_ps(magnitude, threshold), _mm512_set1_ps(0.3f), threshold), one);
+            const __mmask16 negative = _mm512_cmp_ps_mask(shaped, zero, _CMP_LT_OQ);
+            const __m512 limited = _mm512_mask_sub_ps(knee, negative, zero, knee);
+
+            shaped = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(magnitude, threshold, _CMP_GT_OQ), shaped, limited);
+            _mm512_mask_storeu_ps(output + i, lanes, _mm512_mul_ps(shaped, _mm512_set1_ps(0.85f)));
+        }
+    }
+
+    DRE_DIMURA_TARGET("avx512f")
+    void multiplyAVX512(float* data, const float* gains, int numSamples)
+    {
+        for (int i = 0; i < numSamples; i += 16)
+        {
+            const __mmask16 lanes = tailMask(numSamples - i);
+            const __m512 product = _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, data + i), _mm512_maskz_loadu_ps(lanes, gains + i));
+            _mm512_mask_storeu_ps(data + i, lanes, product);
+        }
+    }
+
+    DRE_DIMURA_TARGET("avx512f")
+    float peakMagnitudeAVX512(const float* data, int numSamples)
+    {
+        __m512 peak = _mm512_setzero_ps();
+
+        // Masked-off lanes load as zero, which never raises the peak
+        for (int i = 0; i < numSamples; i += 16)
+            peak = _mm512_max_ps(peak, _mm512_abs_ps(_mm512_maskz_loadu_ps(tailMask(numSamples - i), data + i)));
+
+        return _mm512_reduce_max_ps(peak);
+    }
+
+    const DspKernels avx512Kernels { KernelIsa::AVX512, "avx512", filamentShapeAVX512, multiplyAVX512, peakMagnitudeAVX512 };
+}
+
+const DspKernels* KernelVariants::avx512() { return &avx512Kernels; }
+
+#else
+
+const DspKernels* KernelVariants::avx512() { return nullptr; }
+
+#endif
@@ -0,0 +1,82 @@
+#include "Kernels.h"
+
+#if DRE_DIMURA_X86_KERNELS
+#include <immintrin.h>
+
+// =============================================================================
+// SSE2 variant (4 lanes). See the scalar reference in Kernels.cpp.
+// =============================================================================
+
+namespace
+{
+    DRE_DIMURA_TARGET("sse2")
+    void filamentShapeSSE2(const float* input, const float* driveValues, float* output, int numSamples)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const __m128 drive = _mm_loadu_ps(driveValues + i);
+
+            // Input gain, then the odd harmonic series
+            const __m128 x = _mm_mul_ps(_mm_loadu_ps(input + i), _mm_add_ps(one, _mm_mul_ps(drive, _mm_set1_ps(3.0f))));
+            const __m128 x2 = _mm_mul_ps(x, x);
+            const __m128 x3 = _mm_mul_ps(x2, x);
+            const __m128 x5 = _mm_mul_ps(x3, x2);
+
+            __m128 shaped = _mm_sub_ps(x, _mm_mul_ps(_mm_mul_ps(x3, _mm_set1_ps(0.2f)), drive));
+            shaped = _mm_add_ps(shaped, _mm_mul_ps(_mm_mul_ps(x5, _mm_set1_ps(0.05f)), drive));
+
+            // Soft-kneed limit where |shaped| exceeds the threshold
+            const __m128 threshold = _mm_sub_ps(one, _mm_mul_ps(drive, _mm_set1_ps(0.3f)));
+            const __m128 magnitude = _mm_andnot_ps(signMask, shaped);
+            const __m128 knee = _mm_min_ps(_mm_add_ps(threshold, _mm_mul_ps(_mm_sub_ps(magnitude, threshold), _mm_set1_ps(0.3f))), one);
+            const __m128 limited = _mm_or_ps(_mm_and_ps(shaped, signMask), knee);
+            const __m128 overThreshold = _mm_cmpgt_ps(magnitude, threshold);
+
+            shaped = _mm_or_ps(_mm_and_ps(overThreshold, limited), _mm_andnot_ps(overThreshold, shaped));
+            _mm_storeu_ps(output + i, _mm_mul_ps(shaped, _mm_set1_ps(0.85f)));
+        }
+
+        KernelVariants::scalar.filamentShape(input + i, driveValues + i, output + i, numSamples - i);
+    }
+
+    DRE_DIMURA_TARGET("sse2")
+    void multiplySSE2(float* data, const float* gains, int numSamples)
+    {
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4)
+            _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), _mm_loadu_ps(gains + i)));
+
+        KernelVariants::scalar.multiply(data + i, gains + i, numSamples - i);
+    }
+
+    DRE_DIMURA_TARGET("sse2")
+    float peakMagnitudeSSE2(const float* data, int numSamples)
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 peak = _mm_setzero_ps();
+
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4)
+            peak = _mm_max_ps(peak, _mm_andnot_ps(signMask, _mm_loadu_ps(data + i)));
+
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, peak);
+
+        return juce::jmax(juce::jmax(lanes[0], lanes[1]), juce::jmax(lanes[2], lanes[3]),
+                          KernelVariants::scalar.peakMagnitude(data + i, numSamples - i));
+    }
+
+    const DspKernels sse2Kernels { KernelIsa::SSE2, "sse2", filamentShapeSSE2, multiplySSE2, peakMagnitudeSSE2 };
+}
+
+const DspKernels* KernelVariants::sse2() { return &sse2Kernels; }
+
+#else
+
+const DspKernels* KernelVariants::sse2() { return nullptr; }
+
+#endif
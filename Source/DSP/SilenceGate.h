@@ -0,0 +1,63 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+/**
+ * SilenceGate - Lets the processor sleep through silence
+ *
+ * Counts how long the input has been silent. Once that is longer than the
+ * tail of everything currently switched on, and the last processed block
+ * came out silent as well, the processor can skip its DSP entirely and
+ * output zeros until signal returns.
+ *
+ * Audio thread only.
+ */
+class SilenceGate
+{
+public:
+    // About -100 dB, matching EffectBase::tailDecayDb
+    static constexpr float silenceThreshold = 1.0e-5f;
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        silentSamples = 0;
+        asleep = false;
+    }
+
+    // Call at the start of a block with the input's peak level. Returns true
+    // while the block can be skipped; any signal wakes the gate immediately.
+    bool isAsleep(float inputPeak, int numSamples) noexcept
+    {
+        if (inputPeak >= silenceThreshold)
+        {
+            reset();
+            return false;
+        }
+
+        silentSamples += numSamples;
+        return asleep;
+    }
+
+    // Call after processing a block with the output's peak level and the
+    // current tail length. Goes to sleep once the tail has rung out.
+    void blockProcessed(float outputPeak, double tailSeconds) noexcept
+    {
+        const auto tailSamples = static_cast<juce::int64>(std::ceil(tailSeconds * sampleRate));
+
+        if (silentSamples > tailSamples && outputPeak < silenceThreshold)
+            asleep = true;
+    }
+
+    bool isSleeping() const noexcept { return asleep; }
+
+private:
+    double sampleRate = 44100.0;
+    juce::int64 silentSamples = 0;  // Consecutive silent input samples
+    bool asleep = false;
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #if defined(_MSC_VER)
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+ #define DRE_DIMURA_STAGE_TIMER_USES_TSC 1
+#else
+ #define DRE_DIMURA_STAGE_TIMER_USES_TSC 0
+#endif
+
+// Compiled in unless the build turns it off (CMake DRE_DIMURA_STAGE_TIMERS)
+#ifndef DRE_DIMURA_STAGE_TIMERS
+ #define DRE_DIMURA_STAGE_TIMERS 1
+#endif
+
+/**
+ * StageProfiler - Opt-in timing of each DSP stage, per block
+ *
+ * Each stage (a preamp, or one stage of an effect chain) records how long
+ * it took for every block into a log2 histogram. Timing reads the CPU's
+ * timestamp counter where there is one (a few ns), otherwise steady_clock,
+ * and is calibrated to nanoseconds only when the statistics are read.
+ *
+ * Disabled, a ScopedStageTimer is one relaxed load and a predictable branch;
+ * built with DRE_DIMURA_STAGE_TIMERS=0 it compiles away entirely. Counters
+ * are written only by the audio thread (plain load/store, no locked RMW)
+ * and read by anyone.
+ */
+class StageProfiler
+{
+public:
+    static constexpr int maxStages = 18;
+    static constexpr int numBuckets = 24;  // Bucket n: under 2^(n + 6) ticks
+
+    // Audio thread
+    static uint64_t now() noexcept
+    {
+       #if DRE_DIMURA_STAGE_TIMER_USES_TSC
+        return static_cast<uint64_t>(__rdtsc());
+       #else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+       #endif
+    }
+
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    void record(int stage, uint64_t ticks) noexcept
+    {
+        auto& counters = stages[static_cast<size_t>(stage)];
+
+        const auto bucket = static_cast<size_t>(juce::jlimit(0, numBuckets - 1, highestBit(ticks) - 5));
+        increment(counters.buckets[bucket]);
+        increment(counters.blocks);
+        counters.totalTicks.store(counters.totalTicks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+
+        if (ticks > counters.maxTicks.load(std::memory_order_relaxed))
+            counters.maxTicks.store(ticks, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    // Any other thread
+
+    // Enabling clears the counters and starts a new calibration period
+    void setEnabled(bool shouldBeEnabled)
+    {
+        if (shouldBeEnabled == isEnabled())
+            return;
+
+        if (shouldBeEnabled)
+        {
+            for (auto& counters : stages)
+                counters.clear();
+
+            calibrationTicks = now();
+            calibrationTime = std::chrono::steady_clock::now();
+        }
+
+        enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+    }
+
+    struct StageStats
+    {
+        uint64_t blocks = 0;
+        double meanNs = 0.0;
+        double maxNs = 0.0;
+        std::array<uint64_t, numBuckets> histogram {};
+    };
+
+    StageStats getStats(int stage) const
+    {
+        const auto& counters = stages[static_cast<size_t>(stage)];
+        const double nsPerTick = getNanosecondsPerTick();
+
+        StageStats stats;
+        stats.blocks = counters.blocks.load(std::memory_order_relaxed);
+        stats.maxNs = static_cast<double>(counters.maxTicks.load(std::memory_order_relaxed)) * nsPerTick;
+
+        if (stats.blocks > 0)
+            stats.meanNs = static_cast<double>(counters.totalTicks.load(std::memory_order_relaxed)) * nsPerTick
+                           / static_cast<double>(stats.blocks);
+
+        for (size_t i = 0; i < stats.histogram.size(); ++i)
+            stats.histogram[i] = counters.buckets[i].load(std::memory_order_relaxed);
+
+        return stats;
+    }
+
+    // Upper edge of a histogram bucket
+    double getBucketUpperNs(int bucket) const
+    {
+        return std::ldexp(1.0, bucket + 6) * getNanosecondsPerTick();
+    }
+
+private:
+    struct Counters
+    {
+        std::atomic<uint64_t> blocks { 0 };
+        std::atomic<uint64_t> totalTicks { 0 };
+        std::atomic<uint64_t> maxTicks { 0 };
+        std::array<std::atomic<uint64_t>, numBuckets> buckets {};
+
+        void clear() noexcept
+        {
+            blocks.store(0);
+            totalTicks.store(0);
+            maxTicks.store(0);
+
+            for (auto& bucket : buckets)
+                bucket.store(0);
+        }
+    };
+
+    static void increment(std::atomic<uint64_t>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    static int highestBit(uint64_t value) noexcept
+    {
+        // A block over 2^32 ticks (over a second) just lands in the top bucket
+        const auto clamped = static_cast<uint32_t>(juce::jmin(value, static_cast<uint64_t>(0xffffffffu)));
+        return clamped == 0 ? 0 : juce::findHighestSetBit(clamped);
+    }
+
+    double getNanosecondsPerTick() const
+    {
+       #if DRE_DIMURA_STAGE_TIMER_USES_TSC
+        // Timestamp counter rate, measured over the time since enabling
+        const auto elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - calibrationTime).count();
+        const auto elapsedTicks = static_cast<double>(now() - calibrationTicks);
+        return elapsedTicks > 0.0 ? elapsedNs / elapsedTicks : 0.0;
+       #else
+        return 1.0;
+       #endif
+    }
+
+    std::atomic<bool> enabled { false };
+    std::array<Counters, maxStages> stages;
+
+    uint64_t calibrationTicks = 0;
+    std::chrono::steady_clock::time_point calibrationTime;
+};
+
+/** Times its scope into a StageProfiler stage, while profiling is enabled */
+class ScopedStageTimer
+{
+public:
+   #if DRE_DIMURA_STAGE_TIMERS
+    ScopedStageTimer(StageProfiler& profilerToUse, int stageIndex) noexcept
+        : profiler(profilerToUse.isEnabled() ? &profilerToUse : nullptr),
+          stage(stageIndex),
+          start(profiler != nullptr ? StageProfiler::now() : 0)
+    {
+    }
+
+    ~ScopedStageTimer()
+    {
+        if (profiler != nullptr)
+            profiler->record(stage, StageProfiler::now() - start);
+    }
+
+private:
+    StageProfiler* profiler;
+    int stage;
+    uint64_t start;
+   #else
+    ScopedStageTimer(StageProfiler&, int) noexcept {}
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE(ScopedStageTimer)
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cmath>
+
+/**
+ * StereoSvf - Topology-preserving (trapezoidal) state-variable filter for
+ * a stereo pair
+ *
+ * Unlike a biquad, its state stays valid when the coefficients change, so
+ * cutoff and resonance can move every sample without zipper noise or
+ * blow-ups. A coefficient update is a handful of multiplies and one divide
+ * on top of the prewarped cutoff gain g = tan(pi * cutoff / sampleRate),
+ * which comes from the shared table (cutoffGainLookup in DspTables.h).
+ *
+ * The low-pass, band-pass, shelf and bell responses are the same bilinear
+ * designs as the corresponding juce::dsp::IIR::ArrayCoefficients makers,
+ * so swapping a StereoBiquad for one of these doesn't change the sound.
+ * Gain factors are linear, as in JUCE.
+ */
+struct StereoSvf
+{
+    // Core coefficients and output mix of (input, band, low)
+    float a1 = 1.0f, a2 = 0.0f, a3 = 0.0f;
+    float m0 = 1.0f, m1 = 0.0f, m2 = 0.0f;
+
+    // Per-channel integrator state
+    float ic1L = 0.0f, ic2L = 0.0f;
+    float ic1R = 0.0f, ic2R = 0.0f;
+
+    void setLowPass(float g, float q) noexcept
+    {
+        setCore(g, 1.0f / q);
+        m0 = 0.0f; m1 = 0.0f; m2 = 1.0f;
+    }
+
+    // Unity gain at the centre frequency
+    void setBandPass(float g, float q) noexcept
+    {
+        const float k = 1.0f / q;
+        setCore(g, k);
+        m0 = 0.0f; m1 = k; m2 = 0.0f;
+    }
+
+    void setLowShelf(float g, float q, float gainFactor) noexcept
+    {
+        const float a = std::sqrt(gainFactor);
+        const float k = 1.0f / q;
+        setCore(g / std::sqrt(a), k);
+        m0 = 1.0f; m1 = k * (a - 1.0f); m2 = gainFactor - 1.0f;
+    }
+
+    void setHighShelf(float g, float q, float gainFactor) noexcept
+    {
+        const float a = std::sqrt(gainFactor);
+        const float k = 1.0f / q;
+        setCore(g * std::sqrt(a), k);
+        m0 = gainFactor; m1 = k * (1.0f - a) * a; m2 = 1.0f - gainFactor;
+    }
+
+    void setBell(float g, float q, float gainFactor) noexcept
+    {
+        const float a = std::sqrt(gainFactor);
+        const float k = 1.0f / (q * a);
+        setCore(g, k);
+        m0 = 1.0f; m1 = k * (gainFactor - 1.0f); m2 = 0.0f;
+    }
+
+    void reset() noexcept
+    {
+        ic1L = ic2L = ic1R = ic2R = 0.0f;
+    }
+
+    float processLeft(float x) noexcept { return tick(x, ic1L, ic2L); }
+    float processRight(float x) noexcept { return tick(x, ic1R, ic2R); }
+
+    float processSample(size_t channel, float x) noexcept
+    {
+        return channel == 0 ? processLeft(x) : processRight(x);
+    }
+
+private:
+    void setCore(float g, float k) noexcept
+    {
+        a1 = 1.0f / (1.0f + g * (g + k));
+        a2 = g * a1;
+        a3 = g * a2;
+    }
+
+    float tick(float x, float& ic1, float& ic2) const noexcept
+    {
+        const float v3 = x - ic2;
+        const float v1 = a1 * ic1 + a2 * v3;  // Band
+        const float v2 = ic2 + a2 * ic1 + a3 * v3;  // Low
+        ic1 = 2.0f * v1 - ic1;
+        ic2 = 2.0f * v2 - ic2;
+        return m0 * x + m1 * v1 + m2 * v2;
+    }
+};
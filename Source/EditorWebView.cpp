@@ -0,0 +1,494 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Editor WebView Implementation
+    Vintage preamp coloration utility
+
+    Uses JUCE 8's native WebView relay system for reliable bidirectional
+    parameter synchronization between C++ and the web UI.
+  ==============================================================================
+*/
+
+#include "EditorWebView.h"
+#include "PluginProcessor.h"
+#include "ParameterIDs.h"
+#include "WebUIResources.h"
+
+#if BEATCONNECT_ACTIVATION_ENABLED
+#include <beatconnect/Activation.h>
+#endif
+
+static constexpr const char* DEV_SERVER_URL = "http://localhost:5173";
+
+//==============================================================================
+EditorWebView::EditorWebView(DreDimuraProcessor& p)
+    : processorRef(p)
+{
+    // Create relays BEFORE WebView (required by JUCE 8 relay system)
+    setupRelays();
+
+    // Create WebView with full configuration
+    setupWebView();
+
+    // Create attachments AFTER WebView
+    createAttachments();
+
+    parkBrowser();
+}
+
+EditorWebView::~EditorWebView() = default;
+
+//==============================================================================
+void EditorWebView::editorOpened(double openStartMs)
+{
+    pendingOpenStartMs = openStartMs;
+    pendingOpenWasWarm = pageLoaded;
+    resourceRequestsAtOpen = resourceRequests.load();
+
+    // A page that's already up missed parameter changes while hidden, and
+    // won't paint a fresh frame on its own: ask it to report its next one
+    // once the editor is on screen
+    if (pageLoaded)
+    {
+        juce::Component::SafePointer<juce::WebBrowserComponent> safeBrowser(webView.get());
+
+        juce::MessageManager::callAsync([this, safeBrowser]
+        {
+            if (safeBrowser == nullptr)
+                return;
+
+            sendInitialUpdates();
+            safeBrowser->emitEventIfBrowserIsVisible("editorShown", juce::var());
+        });
+    }
+}
+
+void EditorWebView::editorClosed()
+{
+    pendingOpenStartMs = 0.0;
+    parkBrowser();
+}
+
+void EditorWebView::parkBrowser()
+{
+    if (! hiddenHost.isOnDesktop())
+    {
+        hiddenHost.setSize(900, 520);
+        hiddenHost.addToDesktop(juce::ComponentPeer::windowIsTemporary
+                                | juce::ComponentPeer::windowIgnoresMouseClicks);
+    }
+
+    hiddenHost.addAndMakeVisible(*webView);
+    webView->setBounds(hiddenHost.getLocalBounds());
+}
+
+void EditorWebView::handleFirstFrame()
+{
+    pageLoaded = true;
+
+    if (pendingOpenStartMs <= 0.0)
+        return;  // Pre-warmed page finishing its load with no editor open
+
+    lastOpenLatencyMs = juce::Time::getMillisecondCounterHiRes() - pendingOpenStartMs;
+    pendingOpenStartMs = 0.0;
+
+    const int reloaded = resourceRequests.load() - resourceRequestsAtOpen;
+
+    juce::Logger::writeToLog("Dre-Dimura: editor first frame after "
+                             + juce::String(lastOpenLatencyMs, 1) + " ms ("
+                             + (pendingOpenWasWarm ? "reused" : "new") + " WebView, "
+                             + juce::String(reloaded) + " UI files loaded)");
+}
+
+void EditorWebView::sendDeadlineStats()
+{
+    const auto stats = processorRef.getDeadlineStats();
+
+    auto* object = new juce::DynamicObject();
+    object->setProperty("blocks", static_cast<juce::int64>(stats.blocks));
+    object->setProperty("meanPercent", stats.meanPercent);
+    object->setProperty("p99Percent", stats.p99Percent);
+    object->setProperty("worstPercent", stats.worstPercent);
+    object->setProperty("over50", static_cast<juce::int64>(stats.over50));
+    object->setProperty("over80", static_cast<juce::int64>(stats.over80));
+    object->setProperty("over100", static_cast<juce::int64>(stats.over100));
+    object->setProperty("xrunRisk", stats.isXrunRisk());
+    object->setProperty("tracing", processorRef.getTraceRecorder().isEnabled());
+    object->setProperty("capturing", processorRef.isCapturing());
+
+    webView->emitEventIfBrowserIsVisible("deadlineStats", juce::var(object));
+}
+
+//==============================================================================
+void EditorWebView::setupRelays()
+{
+    // Relay names MUST match parameter IDs exactly
+    driveRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::drive);
+    toneRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::tone);
+    outputRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::output);
+    bypassRelay = std::make_unique<juce::WebToggleButtonRelay>(ParameterIDs::bypass);
+    preampTypeRelay = std::make_unique<juce::WebComboBoxRelay>(ParameterIDs::preampType);
+
+    // Cathode effect relays
+    cathEmberRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::cath_ember);
+    cathHazeRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::cath_haze);
+    cathEchoRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::cath_echo);
+    cathDriftRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::cath_drift);
+    cathVelvetRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::cath_velvet);
+
+    // Filament effect relays
+    filFractureRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::fil_fracture);
+    filGlistenRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::fil_glisten);
+    filCascadeRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::fil_cascade);
+    filPhaseRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::fil_phase);
+    filPrismRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::fil_prism);
+
+    // Steel Plate effect relays
+    steelScorchRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::steel_scorch);
+    steelRustRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::steel_rust);
+    steelGrindRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::steel_grind);
+    steelShredRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::steel_shred);
+    steelSnarlRelay = std::make_unique<juce::WebSliderRelay>(ParameterIDs::steel_snarl);
+}
+
+//==============================================================================
+void EditorWebView::setupWebView()
+{
+    // ===========================================================================
+    // Build WebBrowserComponent with JUCE 8 options
+    // ===========================================================================
+    // The UI is served from memory (see WebUIResources.h), never from disk.
+    // The page stays loaded while the browser is hidden, so a reopened
+    // editor requests nothing.
+    auto options = juce::WebBrowserComponent::Options()
+        .withBackend(juce::WebBrowserComponent::Options::Backend::webview2)
+        .withNativeIntegrationEnabled()
+        .withKeepPageLoadedWhenBrowserIsHidden()
+        .withResourceProvider([this](const juce::String& url)
+        {
+            ++resourceRequests;
+            return getWebUIResource(url);
+        })
+        // Register all relays
+        .withOptionsFrom(*driveRelay)
+        .withOptionsFrom(*toneRelay)
+        .withOptionsFrom(*outputRelay)
+        .withOptionsFrom(*bypassRelay)
+        .withOptionsFrom(*preampTypeRelay)
+        // Cathode effect relays
+        .withOptionsFrom(*cathEmberRelay)
+        .withOptionsFrom(*cathHazeRelay)
+        .withOptionsFrom(*cathEchoRelay)
+        .withOptionsFrom(*cathDriftRelay)
+        .withOptionsFrom(*cathVelvetRelay)
+        // Filament effect relays
+        .withOptionsFrom(*filFractureRelay)
+        .withOptionsFrom(*filGlistenRelay)
+        .withOptionsFrom(*filCascadeRelay)
+        .withOptionsFrom(*filPhaseRelay)
+        .withOptionsFrom(*filPrismRelay)
+        // Steel Plate effect relays
+        .withOptionsFrom(*steelScorchRelay)
+        .withOptionsFrom(*steelRustRelay)
+        .withOptionsFrom(*steelGrindRelay)
+        .withOptionsFrom(*steelShredRelay)
+        .withOptionsFrom(*steelSnarlRelay)
+        // Activation event listeners
+        .withEventListener("activateLicense", [this](const juce::var& data) {
+            TraceRecorder::Scope trace(processorRef.getTraceRecorder(), TraceRecorder::activation, "activateLicense");
+            handleActivateLicense(data);
+        })
+        .withEventListener("deactivateLicense", [this](const juce::var& data) {
+            TraceRecorder::Scope trace(processorRef.getTraceRecorder(), TraceRecorder::activation, "deactivateLicense");
+            handleDeactivateLicense(data);
+        })
+        .withEventListener("getActivationStatus", [this](const juce::var&) {
+            TraceRecorder::Scope trace(processorRef.getTraceRecorder(), TraceRecorder::activation, "getActivationStatus");
+            handleGetActivationStatus();
+        })
+        // Preset selected in the UI: applied natively, in one go
+        .withEventListener("applyPreset", [this](const juce::var& data) {
+            TraceRecorder::Scope trace(processorRef.getTraceRecorder(), TraceRecorder::webView, "applyPreset");
+            const auto id = data.getProperty("id", juce::var()).toString();
+            processorRef.applyPreset(processorRef.getPresetBank().indexOf(id));
+        })
+        // Hidden performance panel (web-ui/src/components/PerformancePanel.tsx)
+        .withEventListener("setStageTiming", [this](const juce::var& data) {
+            processorRef.setStageTimingEnabled(data.getProperty("enabled", false));
+        })
+        .withEventListener("getStageTimings", [this](const juce::var&) {
+            webView->emitEventIfBrowserIsVisible("stageTimings", processorRef.getStageTimings());
+        })
+        .withEventListener("getDeadlineStats", [this](const juce::var&) {
+            sendDeadlineStats();
+        })
+        .withEventListener("resetDeadlineStats", [this](const juce::var&) {
+            processorRef.resetDeadlineStats();
+        })
+        .withEventListener("setTracing", [this](const juce::var& data) {
+            processorRef.getTraceRecorder().setEnabled(data.getProperty("enabled", false));
+        })
+        .withEventListener("dumpTrace", [this](const juce::var&) {
+            processorRef.getTraceRecorder().requestDump();
+        })
+        .withEventListener("setCapture", [this](const juce::var& data) {
+            if (data.getProperty("enabled", false))
+                processorRef.startCapture();
+            else
+                processorRef.stopCapture();
+
+            sendDeadlineStats();
+        })
+        .withEventListener("logDeadlineStats", [this](const juce::var&) {
+            processorRef.logDeadlineStats();
+        })
+        // Editor open latency (see web-ui/src/lib/first-frame.ts)
+        .withEventListener("editorFirstFrame", [this](const juce::var&) {
+            TraceRecorder::Scope trace(processorRef.getTraceRecorder(), TraceRecorder::webView, "editorFirstFrame");
+            handleFirstFrame();
+        })
+        .withWinWebView2Options(
+            juce::WebBrowserComponent::Options::WinWebView2()
+                .withBackgroundColour(juce::Colour(0xff1a1a2e))
+                .withStatusBarDisabled()
+                .withUserDataFolder(
+                    juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getChildFile("DreDimura_WebView2")));
+
+    webView = std::make_unique<juce::WebBrowserComponent>(options);
+
+    // ===========================================================================
+    // Load URL based on build mode
+    // ===========================================================================
+#if DRE_DIMURA_DEV_MODE
+    webView->goToURL(DEV_SERVER_URL);
+#else
+    webView->goToURL(webView->getResourceProviderRoot());
+#endif
+}
+
+//==============================================================================
+void EditorWebView::createAttachments()
+{
+    auto& apvts = processorRef.getAPVTS();
+    driveAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::drive), *driveRelay, nullptr);
+    toneAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::tone), *toneRelay, nullptr);
+    outputAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::output), *outputRelay, nullptr);
+    bypassAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::bypass), *bypassRelay, nullptr);
+    preampTypeAttachment = std::make_unique<juce::WebComboBoxParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::preampType), *preampTypeRelay, nullptr);
+
+    // Cathode effect attachments
+    cathEmberAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::cath_ember), *cathEmberRelay, nullptr);
+    cathHazeAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::cath_haze), *cathHazeRelay, nullptr);
+    cathEchoAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::cath_echo), *cathEchoRelay, nullptr);
+    cathDriftAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::cath_drift), *cathDriftRelay, nullptr);
+    cathVelvetAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::cath_velvet), *cathVelvetRelay, nullptr);
+
+    // Filament effect attachments
+    filFractureAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::fil_fracture), *filFractureRelay, nullptr);
+    filGlistenAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::fil_glisten), *filGlistenRelay, nullptr);
+    filCascadeAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::fil_cascade), *filCascadeRelay, nullptr);
+    filPhaseAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::fil_phase), *filPhaseRelay, nullptr);
+    filPrismAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::fil_prism), *filPrismRelay, nullptr);
+
+    // Steel Plate effect attachments
+    steelScorchAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::steel_scorch), *steelScorchRelay, nullptr);
+    steelRustAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::steel_rust), *steelRustRelay, nullptr);
+    steelGrindAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::steel_grind), *steelGrindRelay, nullptr);
+    steelShredAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::steel_shred), *steelShredRelay, nullptr);
+    steelSnarlAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+        *apvts.getParameter(ParameterIDs::steel_snarl), *steelSnarlRelay, nullptr);
+}
+
+void EditorWebView::sendInitialUpdates()
+{
+    driveAttachment->sendInitialUpdate();
+    toneAttachment->sendInitialUpdate();
+    outputAttachment->sendInitialUpdate();
+    bypassAttachment->sendInitialUpdate();
+    preampTypeAttachment->sendInitialUpdate();
+
+    cathEmberAttachment->sendInitialUpdate();
+    cathHazeAttachment->sendInitialUpdate();
+    cathEchoAttachment->sendInitialUpdate();
+    cathDriftAttachment->sendInitialUpdate();
+    cathVelvetAttachment->sendInitialUpdate();
+
+    filFractureAttachment->sendInitialUpdate();
+    filGlistenAttachment->sendInitialUpdate();
+    filCascadeAttachment->sendInitialUpdate();
+    filPhaseAttachment->sendInitialUpdate();
+    filPrismAttachment->sendInitialUpdate();
+
+    steelScorchAttachment->sendInitialUpdate();
+    steelRustAttachment->sendInitialUpdate();
+    steelGrindAttachment->sendInitialUpdate();
+    steelShredAttachment->sendInitialUpdate();
+    steelSnarlAttachment->sendInitialUpdate();
+}
+
+//==============================================================================
+// Activation Handlers
+//==============================================================================
+
+void EditorWebView::sendActivationState()
+{
+    if (!webView)
+        return;
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+
+#if BEATCONNECT_ACTIVATION_ENABLED
+    auto* activation = processorRef.getActivation();
+
+    bool isConfigured = activation != nullptr;
+    bool isActivated = activation && activation->isActivated();
+
+    data->setProperty("isConfigured", isConfigured);
+    data->setProperty("isActivated", isActivated);
+
+    if (isActivated && activation)
+    {
+        if (auto info = activation->getActivationInfo())
+        {
+            juce::DynamicObject::Ptr infoObj = new juce::DynamicObject();
+            infoObj->setProperty("activationCode", juce::String(info->activationCode));
+            infoObj->setProperty("machineId", juce::String(info->machineId));
+            infoObj->setProperty("activatedAt", juce::String(info->activatedAt));
+            infoObj->setProperty("currentActivations", info->currentActivations);
+            infoObj->setProperty("maxActivations", info->maxActivations);
+            infoObj->setProperty("isValid", info->isValid);
+            data->setProperty("info", juce::var(infoObj.get()));
+        }
+    }
+#else
+    // Activation not enabled - report as not configured (no dialog shown)
+    data->setProperty("isConfigured", false);
+    data->setProperty("isActivated", true);  // Allow full access when activation disabled
+#endif
+
+    webView->emitEventIfBrowserIsVisible("activationState", juce::var(data.get()));
+}
+
+void EditorWebView::handleActivateLicense(const juce::var& data)
+{
+#if BEATCONNECT_ACTIVATION_ENABLED
+    juce::String code = data.getProperty("code", "").toString();
+    if (code.isEmpty())
+        return;
+
+    // Use weak reference for async callback safety. The browser lives as
+    // long as this object, which lives as long as the processor.
+    juce::Component::SafePointer<juce::WebBrowserComponent> safeBrowser(webView.get());
+
+    auto* activation = processorRef.getActivation();
+    if (!activation) return;
+
+    activation->activateAsync(code.toStdString(),
+        [this, safeBrowser](beatconnect::ActivationStatus status) {
+            juce::MessageManager::callAsync([this, safeBrowser, status]() {
+                if (!safeBrowser)
+                    return;
+
+                juce::DynamicObject::Ptr result = new juce::DynamicObject();
+
+                juce::String statusStr;
+                switch (status)
+                {
+                    case beatconnect::ActivationStatus::Valid:         statusStr = "valid"; break;
+                    case beatconnect::ActivationStatus::Invalid:       statusStr = "invalid"; break;
+                    case beatconnect::ActivationStatus::Revoked:       statusStr = "revoked"; break;
+                    case beatconnect::ActivationStatus::MaxReached:    statusStr = "max_reached"; break;
+                    case beatconnect::ActivationStatus::NetworkError:  statusStr = "network_error"; break;
+                    case beatconnect::ActivationStatus::ServerError:   statusStr = "server_error"; break;
+                    case beatconnect::ActivationStatus::NotConfigured: statusStr = "not_configured"; break;
+                    case beatconnect::ActivationStatus::AlreadyActive: statusStr = "already_active"; break;
+                    case beatconnect::ActivationStatus::NotActivated:  statusStr = "not_activated"; break;
+                    default: statusStr = "unknown"; break;
+                }
+                result->setProperty("status", statusStr);
+
+                // If successful, include activation info
+                if (status == beatconnect::ActivationStatus::Valid ||
+                    status == beatconnect::ActivationStatus::AlreadyActive)
+                {
+                    auto* activation = processorRef.getActivation();
+                    if (activation)
+                    {
+                        if (auto info = activation->getActivationInfo())
+                        {
+                            juce::DynamicObject::Ptr infoObj = new juce::DynamicObject();
+                            infoObj->setProperty("activationCode", juce::String(info->activationCode));
+                            infoObj->setProperty("machineId", juce::String(info->machineId));
+                            infoObj->setProperty("activatedAt", juce::String(info->activatedAt));
+                            infoObj->setProperty("currentActivations", info->currentActivations);
+                            infoObj->setProperty("maxActivations", info->maxActivations);
+                            infoObj->setProperty("isValid", info->isValid);
+                            result->setProperty("info", juce::var(infoObj.get()));
+                        }
+                    }
+                }
+
+                safeBrowser->emitEventIfBrowserIsVisible("activationResult", juce::var(result.get()));
+            });
+        });
+#else
+    juce::ignoreUnused(data);
+#endif
+}
+
+void EditorWebView::handleDeactivateLicense([[maybe_unused]] const juce::var& data)
+{
+#if BEATCONNECT_ACTIVATION_ENABLED
+    juce::Component::SafePointer<juce::WebBrowserComponent> safeBrowser(webView.get());
+
+    auto* activation = processorRef.getActivation();
+    if (!activation) return;
+
+    std::thread([safeBrowser, activation]() {
+        auto status = activation->deactivate();
+
+        juce::MessageManager::callAsync([safeBrowser, status]() {
+            if (!safeBrowser)
+                return;
+
+            juce::DynamicObject::Ptr result = new juce::DynamicObject();
+            juce::String statusStr;
+            switch (status)
+            {
+                case beatconnect::ActivationStatus::Valid:         statusStr = "valid"; break;
+                case beatconnect::ActivationStatus::NetworkError:  statusStr = "network_error"; break;
+                case beatconnect::ActivationStatus::ServerError:   statusStr = "server_error"; break;
+                case beatconnect::ActivationStatus::NotActivated:  statusStr = "not_activated"; break;
+                default: statusStr = "unknown"; break;
+            }
+            result->setProperty("status", statusStr);
+
+            safeBrowser->emitEventIfBrowserIsVisible("deactivationResult", juce::var(result.get()));
+        });
+    }).detach();
+#endif
+}
+
+void EditorWebView::handleGetActivationStatus()
+{
+    sendActivationState();
+}
@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Editor WebView
+    Vintage preamp coloration utility
+
+    The WebView, its parameter relays and attachments, kept alive by the
+    processor for its whole lifetime. An editor only borrows it, so reopening
+    the GUI shows the already-loaded page instead of constructing a browser,
+    re-registering the relays and re-parsing the UI bundle every time.
+
+    While no editor holds the browser it sits in a hidden native window, so
+    it has a window to load into (WebView2 needs one) and is never sent to
+    about:blank. The first processor in the process pre-warms its view
+    shortly after loading (see DreDimuraProcessor::timerCallback), so even
+    the first editor usually opens onto a loaded page.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_extra/juce_gui_extra.h>
+
+class DreDimuraProcessor;
+
+//==============================================================================
+class EditorWebView
+{
+public:
+    explicit EditorWebView(DreDimuraProcessor&);
+    ~EditorWebView();
+
+    juce::WebBrowserComponent& getBrowser() noexcept { return *webView; }
+
+    // An editor has taken the browser as its child. openStartMs is
+    // Time::getMillisecondCounterHiRes() when the editor started opening,
+    // for the time-to-first-frame measurement.
+    void editorOpened(double openStartMs);
+
+    // The editor is going away; the browser goes back to the hidden window,
+    // still loaded
+    void editorClosed();
+
+    // Editor open to first painted UI frame, for the latest open (0 until
+    // one has been measured)
+    double getLastOpenLatencyMs() const noexcept { return lastOpenLatencyMs; }
+
+private:
+    //==============================================================================
+    DreDimuraProcessor& processorRef;
+
+    //==============================================================================
+    // JUCE 8 Parameter Relays - MUST be created before WebView
+    std::unique_ptr<juce::WebSliderRelay> driveRelay;
+    std::unique_ptr<juce::WebSliderRelay> toneRelay;
+    std::unique_ptr<juce::WebSliderRelay> outputRelay;
+    std::unique_ptr<juce::WebToggleButtonRelay> bypassRelay;
+    std::unique_ptr<juce::WebComboBoxRelay> preampTypeRelay;
+
+    // Cathode effect relays
+    std::unique_ptr<juce::WebSliderRelay> cathEmberRelay;
+    std::unique_ptr<juce::WebSliderRelay> cathHazeRelay;
+    std::unique_ptr<juce::WebSliderRelay> cathEchoRelay;
+    std::unique_ptr<juce::WebSliderRelay> cathDriftRelay;
+    std::unique_ptr<juce::WebSliderRelay> cathVelvetRelay;
+
+    // Filament effect relays
+    std::unique_ptr<juce::WebSliderRelay> filFractureRelay;
+    std::unique_ptr<juce::WebSliderRelay> filGlistenRelay;
+    std::unique_ptr<juce::WebSliderRelay> filCascadeRelay;
+    std::unique_ptr<juce::WebSliderRelay> filPhaseRelay;
+    std::unique_ptr<juce::WebSliderRelay> filPrismRelay;
+
+    // Steel Plate effect relays
+    std::unique_ptr<juce::WebSliderRelay> steelScorchRelay;
+    std::unique_ptr<juce::WebSliderRelay> steelRustRelay;
+    std::unique_ptr<juce::WebSliderRelay> steelGrindRelay;
+    std::unique_ptr<juce::WebSliderRelay> steelShredRelay;
+    std::unique_ptr<juce::WebSliderRelay> steelSnarlRelay;
+
+    //==============================================================================
+    // Hidden native window holding the browser while no editor shows it
+    juce::Component hiddenHost;
+
+    // WebView component
+    std::unique_ptr<juce::WebBrowserComponent> webView;
+
+    //==============================================================================
+    // Parameter Attachments - created AFTER WebView
+    std::unique_ptr<juce::WebSliderParameterAttachment> driveAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> toneAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> outputAttachment;
+    std::unique_ptr<juce::WebToggleButtonParameterAttachment> bypassAttachment;
+    std::unique_ptr<juce::WebComboBoxParameterAttachment> preampTypeAttachment;
+
+    // Cathode effect attachments
+    std::unique_ptr<juce::WebSliderParameterAttachment> cathEmberAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> cathHazeAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> cathEchoAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> cathDriftAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> cathVelvetAttachment;
+
+    // Filament effect attachments
+    std::unique_ptr<juce::WebSliderParameterAttachment> filFractureAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> filGlistenAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> filCascadeAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> filPhaseAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> filPrismAttachment;
+
+    // Steel Plate effect attachments
+    std::unique_ptr<juce::WebSliderParameterAttachment> steelScorchAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> steelRustAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> steelGrindAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> steelShredAttachment;
+    std::unique_ptr<juce::WebSliderParameterAttachment> steelSnarlAttachment;
+
+    //==============================================================================
+    // Time-to-first-frame: set while an editor open is waiting for the page
+    // to report a painted frame
+    double pendingOpenStartMs = 0.0;
+    bool pendingOpenWasWarm = false;
+    bool pageLoaded = false;  // The page has reported at least one frame
+    double lastOpenLatencyMs = 0.0;
+
+    // Requests served from the embedded UI, and the count when the pending
+    // open started: a reused page makes none
+    std::atomic<int> resourceRequests { 0 };
+    int resourceRequestsAtOpen = 0;
+
+    //==============================================================================
+    void setupRelays();
+    void setupWebView();
+    void createAttachments();
+
+    // Puts the browser in hiddenHost, which goes on the desktop (hidden) the
+    // first time
+    void parkBrowser();
+
+    // Re-sends every parameter value, for a page that missed updates while
+    // no editor was showing it
+    void sendInitialUpdates();
+
+    // The page painted its first frame since load or since "editorShown"
+    void handleFirstFrame();
+
+    // Emits "deadlineStats" for the performance panel
+    void sendDeadlineStats();
+
+    //==============================================================================
+    // Activation handlers (always declared, conditionally implemented)
+    void sendActivationState();
+    void handleActivateLicense(const juce::var& data);
+    void handleDeactivateLicense(const juce::var& data);
+    void handleGetActivationStatus();
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditorWebView)
+};
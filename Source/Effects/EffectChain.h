@@ -0,0 +1,132 @@
+#pragma once
+
+#include "EffectsDSP.h"
+#include "../DSP/StageProfiler.h"
+#include <tuple>
+#include <utility>
+
+/**
+ * EffectChain - Compile-time composition of an effect chain
+ *
+ * Each preamp's chain is fixed, so instead of calling every effect through
+ * EffectBase::process the chain is a fold over the concrete (final) effect
+ * types: every call is statically bound and can be inlined.
+ *
+ *   processEffectChain(left, right, numSamples,
+ *                      fuse(cathEmber, cathVelvet), cathDrift, cathEcho, cathHaze);
+ *
+ * fuse() runs adjacent effects without delay memory in one per-sample loop
+ * through their processFrame() kernels. That is sample-exact with running
+ * them one after the other, but makes one pass over the block instead of two.
+ *
+ * Every effect goes through EffectBase::beginProcessing() once per block, so
+ * dormant effects are skipped entirely (see the lifecycle in EffectsDSP.h).
+ *
+ * processTimedEffectChain() does the same, timing each stage into its own
+ * StageProfiler stage (a fused stage counts as one).
+ */
+
+// =============================================================================
+// FusedStage
+// =============================================================================
+
+template <typename... Effects>
+class FusedStage
+{
+public:
+    explicit FusedStage(Effects&... effectsToFuse) : effects(effectsToFuse...) {}
+
+    void process(float* leftChannel, float* rightChannel, int numSamples) noexcept
+    {
+        process(leftChannel, rightChannel, numSamples, std::index_sequence_for<Effects...>());
+    }
+
+private:
+    template <size_t... Index>
+    void process(float* leftChannel, float* rightChannel, int numSamples, std::index_sequence<Index...>) noexcept
+    {
+        const bool active[] = { std::get<Index>(effects).beginProcessing()... };
+
+        if (! (active[Index] || ...))
+            return;
+
+        ((active[Index] ? std::get<Index>(effects).beginBlock() : void()), ...);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto& left = leftChannel[i];
+            auto& right = rightChannel[i];
+            ((active[Index] ? std::get<Index>(effects).processFrame(left, right) : void()), ...);
+        }
+    }
+
+    std::tuple<Effects&...> effects;
+};
+
+template <typename... Effects>
+FusedStage<Effects...> fuse(Effects&... effects)
+{
+    return FusedStage<Effects...>(effects...);
+}
+
+// =============================================================================
+// Stage dispatch
+// =============================================================================
+
+namespace EffectChainDetail
+{
+    // A single effect: only runs once its delay memory is there and it is
+    // not dormant. The owner allocates a chain's memory before running it,
+    // so waiting is a last resort; returns true if it happens (the caller
+    // then requests the memory).
+    template <typename Effect>
+    bool processStage(Effect& effect, float* leftChannel, float* rightChannel, int numSamples)
+    {
+        if (! effect.ensureDelayMemory())
+            return effect.isDelayMemoryRequested();
+
+        if (effect.beginProcessing())
+            effect.process(leftChannel, rightChannel, numSamples);
+
+        return false;
+    }
+
+    // Fused effects never have delay memory to wait for
+    template <typename... Effects>
+    bool processStage(FusedStage<Effects...>& stage, float* leftChannel, float* rightChannel, int numSamples)
+    {
+        stage.process(leftChannel, rightChannel, numSamples);
+        return false;
+    }
+
+    template <typename Stage>
+    bool processTimedStage(StageProfiler& profiler, int stageIndex, Stage& stage,
+                           float* leftChannel, float* rightChannel, int numSamples)
+    {
+        ScopedStageTimer timer(profiler, stageIndex);
+        return processStage(stage, leftChannel, rightChannel, numSamples);
+    }
+}
+
+// Runs the stages in order. Returns true if any effect is waiting for its
+// delay memory.
+template <typename... Stages>
+bool processEffectChain(float* leftChannel, float* rightChannel, int numSamples, Stages&&... stages)
+{
+    bool waitingForMemory = false;
+    ((waitingForMemory |= EffectChainDetail::processStage(stages, leftChannel, rightChannel, numSamples)), ...);
+    return waitingForMemory;
+}
+
+// Runs the stages in order, timing them into consecutive profiler stages
+// from firstStage on
+template <typename... Stages>
+bool processTimedEffectChain(StageProfiler& profiler, int firstStage,
+                             float* leftChannel, float* rightChannel, int numSamples, Stages&&... stages)
+{
+    bool waitingForMemory = false;
+    int stageIndex = firstStage;
+    ((waitingForMemory |= EffectChainDetail::processTimedStage(profiler, stageIndex++, stages,
+                                                               leftChannel, rightChannel, numSamples)), ...);
+    return waitingForMemory;
+}
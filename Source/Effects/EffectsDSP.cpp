@@ -1,97 +1,192 @@
 #include "EffectsDSP.h"
 
 // =============================================================================
-// CATHODE EFFECTS Implementation
+// EffectBase
 // =============================================================================
 
-// --- Ember: Tube Saturation ---
-void EmberDSP::prepare(const juce::dsp::ProcessSpec& spec)
+void EffectBase::addDelayBuffer(DelayBuffer& buffer)
 {
-    EffectBase::prepare(spec);
-    lastSampleL = 0.0f;
-    lastSampleR = 0.0f;
+    jassert(numDelayBuffers < maxDelayBuffers);
+    delayBuffers[static_cast<size_t>(numDelayBuffers++)] = &buffer;
 }
 
-void EmberDSP::reset()
+void EffectBase::prepareDelayBuffer(DelayBuffer& buffer, double seconds, int extraSamples)
 {
-    EffectBase::reset();
-    lastSampleL = 0.0f;
-    lastSampleR = 0.0f;
+    const double maxSampleRate = juce::jmax(sampleRate, maxReservedSampleRate);
+    const double maxWetSampleRate = reducedRateWetPath
+        ? maxSampleRate / HalfBandResampler::getRateFactorForSampleRate(maxSampleRate)
+        : maxSampleRate;
+
+    buffer.length = static_cast<int>(seconds * wetSampleRate) + extraSamples;
+    buffer.reservedLength = static_cast<int>(seconds * juce::jmax(wetSampleRate, maxWetSampleRate)) + extraSamples;
+}
+
+size_t EffectBase::getReservedDelayMemorySize() const
+{
+    size_t total = 0;
+    for (int i = 0; i < numDelayBuffers; ++i)
+        total += DspArena::getAllocationSize(static_cast<size_t>(delayBuffers[static_cast<size_t>(i)]->reservedLength)
+                                             * DelayBuffer::floatsPerFrame);
+    return total;
 }
 
-float EmberDSP::processSample(float input)
+void EffectBase::allocateDelayMemory(DspArena& arena)
 {
-    // Asymmetric tube-style saturation with even harmonics
-    float x = input * 2.0f;  // Boost into saturation
+    if (numDelayBuffers == 0 || delayMemoryReady.load(std::memory_order_acquire))
+        return;
 
-    // Positive half: softer clipping (even harmonics)
-    if (x > 0.0f)
+    for (int i = 0; i < numDelayBuffers; ++i)
     {
-        x = std::tanh(x * 0.8f) * 1.1f;
+        auto& buffer = *delayBuffers[static_cast<size_t>(i)];
+        buffer.data = reinterpret_cast<StereoFrame*>(
+            arena.allocateFloats(static_cast<size_t>(buffer.length) * DelayBuffer::floatsPerFrame));
     }
-    // Negative half: harder clipping
-    else
+
+    delayMemoryRequested.store(false, std::memory_order_release);
+    delayMemoryReady.store(true, std::memory_order_release);
+}
+
+void EffectBase::releaseDelayMemory()
+{
+    // Only called from prepare(), while the audio thread is stopped
+    delayMemoryReady.store(false, std::memory_order_release);
+    delayMemoryRequested.store(false, std::memory_order_release);
+    delayBuffersStale = false;
+
+    for (int i = 0; i < numDelayBuffers; ++i)
+        delayBuffers[static_cast<size_t>(i)]->data = nullptr;
+}
+
+void EffectBase::reset()
+{
+    mix.reset(sampleRate, 0.02);
+    clearDelayBuffers();
+    resetState();
+
+    lifecycle = isInUse() ? Lifecycle::Active : Lifecycle::Dormant;
+    delayBuffersStale = false;
+}
+
+void EffectBase::clearDelayBuffers()
+{
+    if (! delayMemoryReady.load(std::memory_order_acquire))
+        return;
+
+    for (int i = 0; i < numDelayBuffers; ++i)
+        delayBuffers[static_cast<size_t>(i)]->clear();
+}
+
+void EffectBase::enterDormant() noexcept
+{
+    lifecycle = Lifecycle::Dormant;
+
+    // Whatever is left in the lines is cleared when (if) the effect wakes
+    delayBuffersStale = numDelayBuffers > 0 && delayMemoryReady.load(std::memory_order_acquire);
+    flushBufferIndex = 0;
+    flushPosition = 0;
+}
+
+void EffectBase::suspend() noexcept
+{
+    enterDormant();
+
+    const float target = mix.getTargetValue();
+    mix.setCurrentAndTargetValue(0.0f);
+    mix.setTargetValue(target);
+}
+
+bool EffectBase::flushDelayBuffers() noexcept
+{
+    if (! delayBuffersStale)
+        return true;
+
+    int budget = flushFramesPerBlock;
+
+    while (flushBufferIndex < numDelayBuffers)
     {
-        x = std::tanh(x * 1.2f);
+        auto& buffer = *delayBuffers[static_cast<size_t>(flushBufferIndex)];
+        const int count = juce::jmin(budget, buffer.size() - flushPosition);
+
+        std::fill(buffer.data + flushPosition, buffer.data + flushPosition + count, StereoFrame {});
+        flushPosition += count;
+        budget -= count;
+
+        if (flushPosition < buffer.size())
+            return false;  // Out of budget, carry on next block
+
+        ++flushBufferIndex;
+        flushPosition = 0;
     }
 
-    return x * 0.7f;  // Output scaling
+    delayBuffersStale = false;
+    return true;
 }
 
-void EmberDSP::process(float* leftChannel, float* rightChannel, int numSamples)
+double EffectBase::feedbackDecaySeconds(double loopSeconds, double loopGain)
 {
-    for (int i = 0; i < numSamples; ++i)
-    {
-        float mixVal = mix.getNextValue();
-        if (mixVal < 0.001f) continue;
+    jassert(loopGain > 0.0 && loopGain < 1.0);
 
-        float dryL = leftChannel[i];
-        float dryR = rightChannel[i];
+    const double numPasses = (tailDecayDb / 20.0) / std::log10(loopGain);
+    return loopSeconds * (1.0 + numPasses);
+}
 
-        // Add subtle low-pass smoothing for warmth
-        float wetL = processSample(dryL * 0.7f + lastSampleL * 0.3f);
-        float wetR = processSample(dryR * 0.7f + lastSampleR * 0.3f);
+// =============================================================================
+// CATHODE EFFECTS Implementation
+// =============================================================================
 
-        lastSampleL = dryL;
-        lastSampleR = dryR;
+// --- Ember: Tube Saturation ---
+void EmberDSP::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    EffectBase::prepare(spec);
+    lastSampleL = 0.0f;
+    lastSampleR = 0.0f;
+}
 
-        leftChannel[i] = dryL + (wetL - dryL) * mixVal;
-        rightChannel[i] = dryR + (wetR - dryR) * mixVal;
-    }
+void EmberDSP::resetState()
+{
+    lastSampleL = 0.0f;
+    lastSampleR = 0.0f;
+}
+
+void EmberDSP::process(float* leftChannel, float* rightChannel, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+        processFrame(leftChannel[i], rightChannel[i]);
 }
 
 // --- Haze: Dark Plate Reverb ---
+HazeDSP::HazeDSP()
+{
+    // Cross-fed lines lose at least half per pass through the longer one
+    tailLengthSeconds = feedbackDecaySeconds(0.053, 0.5);
+
+    // Everything it feeds back is low-passed at 2kHz
+    reducedRateWetPath = true;
+
+    addDelayBuffer(delayBuffer1);
+    addDelayBuffer(delayBuffer2);
+}
+
 void HazeDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
+    resampler.setRateFactor(wetRateFactor);
 
     // Initialize delay lines for diffuse reverb
-    int delay1 = static_cast<int>(0.037 * sampleRate);  // ~37ms
-    int delay2 = static_cast<int>(0.053 * sampleRate);  // ~53ms
-
-    delayBufferL1.resize(delay1, 0.0f);
-    delayBufferL2.resize(delay2, 0.0f);
-    delayBufferR1.resize(delay1, 0.0f);
-    delayBufferR2.resize(delay2, 0.0f);
+    prepareDelayBuffer(delayBuffer1, 0.037);  // ~37ms
+    prepareDelayBuffer(delayBuffer2, 0.053);  // ~53ms
 
     writePos1 = 0;
     writePos2 = 0;
 
     // Dark low-pass at 2kHz
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 2000.0f, 0.7f);
-    lpfL.coefficients = coeffs;
-    lpfR.coefficients = coeffs;
+    lpf.setCoefficients(juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(wetSampleRate, 2000.0f, 0.7f));
 }
 
-void HazeDSP::reset()
+void HazeDSP::resetState()
 {
-    EffectBase::reset();
-    std::fill(delayBufferL1.begin(), delayBufferL1.end(), 0.0f);
-    std::fill(delayBufferL2.begin(), delayBufferL2.end(), 0.0f);
-    std::fill(delayBufferR1.begin(), delayBufferR1.end(), 0.0f);
-    std::fill(delayBufferR2.begin(), delayBufferR2.end(), 0.0f);
-    lpfL.reset();
-    lpfR.reset();
+    lpf.reset();
+    resampler.reset();
     feedbackL = feedbackR = 0.0f;
 }
 
@@ -105,66 +200,73 @@ void HazeDSP::process(float* leftChannel, float* rightChannel, int numSamples)
         float dryL = leftChannel[i];
         float dryR = rightChannel[i];
 
-        // Read from delay lines
-        float tap1L = delayBufferL1[writePos1];
-        float tap2L = delayBufferL2[writePos2];
-        float tap1R = delayBufferR1[writePos1];
-        float tap2R = delayBufferR2[writePos2];
+        if (resampler.pushInput({ dryL, dryR }))
+            resampler.interpolate(processWet(resampler.getDecimated()));
 
-        // Mix taps and apply feedback
-        float wetL = lpfL.processSample(tap1L * 0.6f + tap2L * 0.4f);
-        float wetR = lpfR.processSample(tap1R * 0.6f + tap2R * 0.4f);
+        const StereoFrame wet = resampler.popInterpolated();
 
-        // Write to delay lines with cross-feedback
-        delayBufferL1[writePos1] = dryL + wetR * 0.45f;
-        delayBufferL2[writePos2] = wetL * 0.5f + dryL * 0.3f;
-        delayBufferR1[writePos1] = dryR + wetL * 0.45f;
-        delayBufferR2[writePos2] = wetR * 0.5f + dryR * 0.3f;
+        leftChannel[i] = dryL + wet.left * mixVal;
+        rightChannel[i] = dryR + wet.right * mixVal;
+    }
+}
 
-        // Advance write positions
-        writePos1 = (writePos1 + 1) % delayBufferL1.size();
-        writePos2 = (writePos2 + 1) % delayBufferL2.size();
+StereoFrame HazeDSP::processWet(StereoFrame dry) noexcept
+{
+    // Read from delay lines
+    const StereoFrame tap1 = delayBuffer1[writePos1];
+    const StereoFrame tap2 = delayBuffer2[writePos2];
 
-        leftChannel[i] = dryL + wetL * mixVal;
-        rightChannel[i] = dryR + wetR * mixVal;
-    }
+    // Mix taps and apply feedback
+    float wetL = lpf.processLeft(tap1.left * 0.6f + tap2.left * 0.4f);
+    float wetR = lpf.processRight(tap1.right * 0.6f + tap2.right * 0.4f);
+
+    // Write to delay lines with cross-feedback
+    delayBuffer1[writePos1] = { dry.left + wetR * 0.45f, dry.right + wetL * 0.45f };
+    delayBuffer2[writePos2] = { wetL * 0.5f + dry.left * 0.3f, wetR * 0.5f + dry.right * 0.3f };
+
+    // Advance write positions
+    writePos1 = (writePos1 + 1) % delayBuffer1.size();
+    writePos2 = (writePos2 + 1) % delayBuffer2.size();
+
+    return { wetL, wetR };
 }
 
 // --- Echo: Tape Delay ---
+EchoDSP::EchoDSP()
+{
+    // Repeats every 350ms at 0.4 feedback (the tape filter only darkens them further)
+    tailLengthSeconds = feedbackDecaySeconds(0.35, 0.4);
+
+    // Repeats are rolled off at 4kHz
+    reducedRateWetPath = true;
+
+    addDelayBuffer(delayBuffer);
+}
+
 void EchoDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
+    resampler.setRateFactor(wetRateFactor);
 
     // ~350ms delay (vintage tape echo time)
-    int delayLength = static_cast<int>(0.35 * sampleRate);
-    delayBufferL.resize(delayLength + 100, 0.0f);  // Extra for modulation
-    delayBufferR.resize(delayLength + 100, 0.0f);
+    prepareDelayBuffer(delayBuffer, 0.35, 100);  // Extra for modulation
     writePos = 0;
     lfoPhase = 0.0f;
 
     // Tape-like tone (gentle roll-off)
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 4000.0f, 0.6f);
-    lpfL.coefficients = coeffs;
-    lpfR.coefficients = coeffs;
+    lpf.setCoefficients(juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(wetSampleRate, 4000.0f, 0.6f));
 }
 
-void EchoDSP::reset()
+void EchoDSP::resetState()
 {
-    EffectBase::reset();
-    std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-    std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
-    lpfL.reset();
-    lpfR.reset();
+    lpf.reset();
+    resampler.reset();
     feedbackL = feedbackR = 0.0f;
     lfoPhase = 0.0f;
 }
 
 void EchoDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 {
-    const float lfoRate = 0.5f;  // Slow wow/flutter
-    const float lfoDepth = 15.0f;  // Samples of modulation
-    const int baseDelay = static_cast<int>(0.35 * sampleRate);
-
     for (int i = 0; i < numSamples; ++i)
     {
         float mixVal = mix.getNextValue();
@@ -173,56 +275,71 @@ void EchoDSP::process(float* leftChannel, float* rightChannel, int numSamples)
         float dryL = leftChannel[i];
         float dryR = rightChannel[i];
 
-        // Wow/flutter modulation
-        float mod = std::sin(lfoPhase * 2.0f * 3.14159f) * lfoDepth;
-        lfoPhase += lfoRate / sampleRate;
-        if (lfoPhase >= 1.0f) lfoPhase -= 1.0f;
+        if (resampler.pushInput({ dryL, dryR }))
+            resampler.interpolate(processWet(resampler.getDecimated()));
 
-        // Modulated read position
-        float readPosF = writePos - baseDelay - mod;
-        if (readPosF < 0) readPosF += delayBufferL.size();
+        const StereoFrame wet = resampler.popInterpolated();
 
-        int readPos = static_cast<int>(readPosF);
-        float frac = readPosF - readPos;
-        int nextPos = (readPos + 1) % delayBufferL.size();
+        leftChannel[i] = dryL + wet.left * mixVal;
+        rightChannel[i] = dryR + wet.right * mixVal;
+    }
+}
+
+StereoFrame EchoDSP::processWet(StereoFrame dry) noexcept
+{
+    const float lfoRate = 0.5f;  // Slow wow/flutter
+    const float lfoDepth = 15.0f / static_cast<float>(wetRateFactor);  // 15 host-rate samples of modulation
+    const int baseDelay = static_cast<int>(0.35 * wetSampleRate);
 
-        // Linear interpolation for smooth modulation
-        float tapL = delayBufferL[readPos] * (1.0f - frac) + delayBufferL[nextPos] * frac;
-        float tapR = delayBufferR[readPos] * (1.0f - frac) + delayBufferR[nextPos] * frac;
+    // Wow/flutter modulation
+    float mod = sineLookup(sineTable, lfoPhase) * lfoDepth;
+    lfoPhase += lfoRate / wetSampleRate;
+    if (lfoPhase >= 1.0f) lfoPhase -= 1.0f;
 
-        // Apply tape tone
-        float wetL = lpfL.processSample(tapL);
-        float wetR = lpfR.processSample(tapR);
+    // Modulated read position
+    float readPosF = writePos - baseDelay - mod;
+    if (readPosF < 0) readPosF += delayBuffer.size();
 
-        // Write with feedback
-        delayBufferL[writePos] = dryL + wetL * 0.4f;
-        delayBufferR[writePos] = dryR + wetR * 0.4f;
+    int readPos = static_cast<int>(readPosF);
+    float frac = readPosF - readPos;
+    int nextPos = (readPos + 1) % delayBuffer.size();
 
-        writePos = (writePos + 1) % delayBufferL.size();
+    // Linear interpolation for smooth modulation
+    const StereoFrame tap = delayBuffer[readPos] * (1.0f - frac) + delayBuffer[nextPos] * frac;
 
-        leftChannel[i] = dryL + wetL * mixVal;
-        rightChannel[i] = dryR + wetR * mixVal;
-    }
+    // Apply tape tone
+    float wetL = lpf.processLeft(tap.left);
+    float wetR = lpf.processRight(tap.right);
+
+    // Write with feedback
+    delayBuffer[writePos] = { dry.left + wetL * 0.4f, dry.right + wetR * 0.4f };
+
+    writePos = (writePos + 1) % delayBuffer.size();
+
+    return { wetL, wetR };
 }
 
 // --- Drift: Tape Chorus ---
+DriftDSP::DriftDSP()
+{
+    // No feedback: just the longest modulated read
+    tailLengthSeconds = 0.03;
+
+    addDelayBuffer(delayBuffer);
+}
+
 void DriftDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
 
     // ~30ms max delay for chorus
-    int delayLength = static_cast<int>(0.03 * sampleRate) + 50;
-    delayBufferL.resize(delayLength, 0.0f);
-    delayBufferR.resize(delayLength, 0.0f);
+    prepareDelayBuffer(delayBuffer, 0.03, 50);
     writePos = 0;
     lfoPhase = 0.0f;
 }
 
-void DriftDSP::reset()
+void DriftDSP::resetState()
 {
-    EffectBase::reset();
-    std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-    std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
     lfoPhase = 0.0f;
 }
 
@@ -241,16 +358,16 @@ void DriftDSP::process(float* leftChannel, float* rightChannel, int numSamples)
         float dryR = rightChannel[i];
 
         // Sine LFO with stereo spread
-        float lfoL = std::sin(lfoPhase * 2.0f * 3.14159f) * lfoDepth;
-        float lfoR = std::sin((lfoPhase + 0.25f) * 2.0f * 3.14159f) * lfoDepth;  // 90 degree offset
+        float lfoL = sineLookup(sineTable, lfoPhase) * lfoDepth;
+        float lfoR = sineLookup(sineTable, lfoPhase + 0.25f) * lfoDepth;  // 90 degree offset
         lfoPhase += lfoRate / sampleRate;
         if (lfoPhase >= 1.0f) lfoPhase -= 1.0f;
 
         // Modulated read positions
         float readPosL = writePos - centerDelay - lfoL;
         float readPosR = writePos - centerDelay - lfoR;
-        if (readPosL < 0) readPosL += delayBufferL.size();
-        if (readPosR < 0) readPosR += delayBufferR.size();
+        if (readPosL < 0) readPosL += delayBuffer.size();
+        if (readPosR < 0) readPosR += delayBuffer.size();
 
         int rPosL = static_cast<int>(readPosL);
         int rPosR = static_cast<int>(readPosR);
@@ -258,15 +375,14 @@ void DriftDSP::process(float* leftChannel, float* rightChannel, int numSamples)
         float fracR = readPosR - rPosR;
 
         // Linear interpolation
-        float wetL = delayBufferL[rPosL] * (1.0f - fracL) +
-                     delayBufferL[(rPosL + 1) % delayBufferL.size()] * fracL;
-        float wetR = delayBufferR[rPosR] * (1.0f - fracR) +
-                     delayBufferR[(rPosR + 1) % delayBufferR.size()] * fracR;
+        float wetL = delayBuffer[rPosL].left * (1.0f - fracL) +
+                     delayBuffer[(rPosL + 1) % delayBuffer.size()].left * fracL;
+        float wetR = delayBuffer[rPosR].right * (1.0f - fracR) +
+                     delayBuffer[(rPosR + 1) % delayBuffer.size()].right * fracR;
 
         // Write dry signal
-        delayBufferL[writePos] = dryL;
-        delayBufferR[writePos] = dryR;
-        writePos = (writePos + 1) % delayBufferL.size();
+        delayBuffer[writePos] = { dryL, dryR };
+        writePos = (writePos + 1) % delayBuffer.size();
 
         leftChannel[i] = dryL + (wetL - dryL) * mixVal * 0.7f;
         rightChannel[i] = dryR + (wetR - dryR) * mixVal * 0.7f;
@@ -278,47 +394,19 @@ void VelvetDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
 
-    // Warm, smooth low-pass at 3kHz with resonance
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 3000.0f, 1.2f);
-    filterL.coefficients = coeffs;
-    filterR.coefficients = coeffs;
+    // Coefficients follow the mix, set on the first processed sample
+    filterMix = -1.0f;
 }
 
-void VelvetDSP::reset()
+void VelvetDSP::resetState()
 {
-    EffectBase::reset();
-    filterL.reset();
-    filterR.reset();
+    filter.reset();
 }
 
 void VelvetDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 {
-    // Get current mix value once per block for coefficient calculation
-    float currentMix = mix.getCurrentValue();
-
-    // Only update coefficients at block rate (not per-sample)
-    if (currentMix > 0.001f)
-    {
-        float cutoff = 3000.0f - currentMix * 2000.0f;  // 3kHz to 1kHz
-        auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, cutoff, 1.0f + currentMix * 0.5f);
-        *filterL.coefficients = *coeffs;
-        *filterR.coefficients = *coeffs;
-    }
-
     for (int i = 0; i < numSamples; ++i)
-    {
-        float mixVal = mix.getNextValue();
-        if (mixVal < 0.001f) continue;
-
-        float dryL = leftChannel[i];
-        float dryR = rightChannel[i];
-
-        float wetL = filterL.processSample(dryL);
-        float wetR = filterR.processSample(dryR);
-
-        leftChannel[i] = dryL + (wetL - dryL) * mixVal;
-        rightChannel[i] = dryR + (wetR - dryR) * mixVal;
-    }
+        processFrame(leftChannel[i], rightChannel[i]);
 }
 
 // =============================================================================
@@ -334,63 +422,40 @@ void FractureDSP::prepare(const juce::dsp::ProcessSpec& spec)
 void FractureDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 {
     for (int i = 0; i < numSamples; ++i)
-    {
-        float mixVal = mix.getNextValue();
-        if (mixVal < 0.001f) continue;
-
-        float dryL = leftChannel[i];
-        float dryR = rightChannel[i];
-
-        // Hard digital clipping with pre-gain based on mix
-        float gain = 1.0f + mixVal * 4.0f;
-        float wetL = std::max(-1.0f, std::min(1.0f, dryL * gain));
-        float wetR = std::max(-1.0f, std::min(1.0f, dryR * gain));
+        processFrame(leftChannel[i], rightChannel[i]);
+}
 
-        // Add subtle aliasing by quantizing
-        float bits = 12.0f - mixVal * 4.0f;  // 12-bit to 8-bit
-        float levels = std::pow(2.0f, bits);
-        wetL = std::round(wetL * levels) / levels;
-        wetR = std::round(wetR * levels) / levels;
+// --- Glisten: Shimmer Reverb ---
+GlistenDSP::GlistenDSP()
+{
+    // Main loop 0.35 * (0.6 reverb + 0.3 * 0.4 shimmer) per 80ms pass, rounded up
+    tailLengthSeconds = feedbackDecaySeconds(0.08, 0.3);
 
-        leftChannel[i] = dryL + (wetL - dryL) * mixVal;
-        rightChannel[i] = dryR + (wetR - dryR) * mixVal;
-    }
+    addDelayBuffer(delayBuffer);
+    addDelayBuffer(shimmerBuffer);
 }
 
-// --- Glisten: Shimmer Reverb ---
 void GlistenDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
 
     // Main reverb delay
-    int delayLength = static_cast<int>(0.08 * sampleRate);
-    delayBufferL.resize(delayLength, 0.0f);
-    delayBufferR.resize(delayLength, 0.0f);
+    prepareDelayBuffer(delayBuffer, 0.08);
 
     // Shimmer pitch-shift buffer
-    int shimmerLength = static_cast<int>(0.04 * sampleRate);
-    shimmerBufferL.resize(shimmerLength, 0.0f);
-    shimmerBufferR.resize(shimmerLength, 0.0f);
+    prepareDelayBuffer(shimmerBuffer, 0.04);
 
     writePos = 0;
     shimmerPos = 0;
     shimmerPhase = 0.0f;
 
     // High-pass to brighten shimmer
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 2000.0f, 0.7f);
-    hpfL.coefficients = coeffs;
-    hpfR.coefficients = coeffs;
+    hpf.setCoefficients(juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(sampleRate, 2000.0f, 0.7f));
 }
 
-void GlistenDSP::reset()
+void GlistenDSP::resetState()
 {
-    EffectBase::reset();
-    std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-    std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
-    std::fill(shimmerBufferL.begin(), shimmerBufferL.end(), 0.0f);
-    std::fill(shimmerBufferR.begin(), shimmerBufferR.end(), 0.0f);
-    hpfL.reset();
-    hpfR.reset();
+    hpf.reset();
     shimmerPhase = 0.0f;
 }
 
@@ -407,33 +472,33 @@ void GlistenDSP::process(float* leftChannel, float* rightChannel, int numSamples
         float dryR = rightChannel[i];
 
         // Read main reverb
-        float reverbL = delayBufferL[writePos];
-        float reverbR = delayBufferR[writePos];
+        const StereoFrame reverb = delayBuffer[writePos];
+        float reverbL = reverb.left;
+        float reverbR = reverb.right;
 
         // Simple pitch-shift via phase vocoder approximation
         shimmerPhase += pitchShiftRatio;
-        if (shimmerPhase >= shimmerBufferL.size()) shimmerPhase -= shimmerBufferL.size();
+        if (shimmerPhase >= shimmerBuffer.size()) shimmerPhase -= shimmerBuffer.size();
 
         int shimmerRead = static_cast<int>(shimmerPhase);
-        float shimmerL = shimmerBufferL[shimmerRead] * 0.3f;
-        float shimmerR = shimmerBufferR[shimmerRead] * 0.3f;
+        const StereoFrame shimmer = shimmerBuffer[shimmerRead] * 0.3f;
+        float shimmerL = shimmer.left;
+        float shimmerR = shimmer.right;
 
         // High-pass the shimmer
-        shimmerL = hpfL.processSample(shimmerL);
-        shimmerR = hpfR.processSample(shimmerR);
+        shimmerL = hpf.processLeft(shimmerL);
+        shimmerR = hpf.processRight(shimmerR);
 
         // Combine
         float wetL = reverbL * 0.6f + shimmerL;
         float wetR = reverbR * 0.6f + shimmerR;
 
         // Write to buffers
-        delayBufferL[writePos] = dryL + wetL * 0.35f;
-        delayBufferR[writePos] = dryR + wetR * 0.35f;
-        shimmerBufferL[shimmerPos] = dryL + reverbL * 0.4f;
-        shimmerBufferR[shimmerPos] = dryR + reverbR * 0.4f;
+        delayBuffer[writePos] = { dryL + wetL * 0.35f, dryR + wetR * 0.35f };
+        shimmerBuffer[shimmerPos] = { dryL + reverbL * 0.4f, dryR + reverbR * 0.4f };
 
-        writePos = (writePos + 1) % delayBufferL.size();
-        shimmerPos = (shimmerPos + 1) % shimmerBufferL.size();
+        writePos = (writePos + 1) % delayBuffer.size();
+        shimmerPos = (shimmerPos + 1) % shimmerBuffer.size();
 
         leftChannel[i] = dryL + wetL * mixVal;
         rightChannel[i] = dryR + wetR * mixVal;
@@ -441,14 +506,20 @@ void GlistenDSP::process(float* leftChannel, float* rightChannel, int numSamples
 }
 
 // --- Cascade: Multi-tap Delay ---
+CascadeDSP::CascadeDSP()
+{
+    // Taps out to 500ms, fed back at 0.15 of the normalised tap sum
+    tailLengthSeconds = feedbackDecaySeconds(0.5, 0.15 * 0.5 * (0.7 + 0.5 + 0.35 + 0.2));
+
+    addDelayBuffer(delayBuffer);
+}
+
 void CascadeDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
 
     // ~500ms max delay
-    int delayLength = static_cast<int>(0.5 * sampleRate);
-    delayBufferL.resize(delayLength, 0.0f);
-    delayBufferR.resize(delayLength, 0.0f);
+    prepareDelayBuffer(delayBuffer, 0.5);
     writePos = 0;
 
     // Set tap times: 125ms, 250ms, 375ms, 500ms
@@ -458,13 +529,6 @@ void CascadeDSP::prepare(const juce::dsp::ProcessSpec& spec)
     tapDelays[3] = static_cast<int>(0.5 * sampleRate) - 1;
 }
 
-void CascadeDSP::reset()
-{
-    EffectBase::reset();
-    std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-    std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
-}
-
 void CascadeDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 {
     for (int i = 0; i < numSamples; ++i)
@@ -476,24 +540,22 @@ void CascadeDSP::process(float* leftChannel, float* rightChannel, int numSamples
         float dryR = rightChannel[i];
 
         // Sum all taps
-        float wetL = 0.0f, wetR = 0.0f;
+        StereoFrame wet {};
         for (int t = 0; t < NUM_TAPS; ++t)
         {
             int readPos = writePos - tapDelays[t];
-            if (readPos < 0) readPos += delayBufferL.size();
-            wetL += delayBufferL[readPos] * tapGains[t];
-            wetR += delayBufferR[readPos] * tapGains[t];
+            if (readPos < 0) readPos += delayBuffer.size();
+            wet = wet + delayBuffer[readPos] * tapGains[t];
         }
 
         // Normalize
-        wetL *= 0.5f;
-        wetR *= 0.5f;
+        float wetL = wet.left * 0.5f;
+        float wetR = wet.right * 0.5f;
 
         // Write with minimal feedback for pristine sound
-        delayBufferL[writePos] = dryL + wetL * 0.15f;
-        delayBufferR[writePos] = dryR + wetR * 0.15f;
+        delayBuffer[writePos] = { dryL + wetL * 0.15f, dryR + wetR * 0.15f };
 
-        writePos = (writePos + 1) % delayBufferL.size();
+        writePos = (writePos + 1) % delayBuffer.size();
 
         leftChannel[i] = dryL + wetL * mixVal;
         rightChannel[i] = dryR + wetR * mixVal;
@@ -501,24 +563,27 @@ void CascadeDSP::process(float* leftChannel, float* rightChannel, int numSamples
 }
 
 // --- Phase: Through-Zero Flanger ---
+PhaseDSP::PhaseDSP()
+{
+    // Feedback reaches 0.8 at full mix over a 10ms line
+    tailLengthSeconds = feedbackDecaySeconds(0.01, 0.8);
+
+    addDelayBuffer(delayBuffer);
+}
+
 void PhaseDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
 
     // ~10ms max delay for flanging
-    int delayLength = static_cast<int>(0.01 * sampleRate) + 10;
-    delayBufferL.resize(delayLength, 0.0f);
-    delayBufferR.resize(delayLength, 0.0f);
+    prepareDelayBuffer(delayBuffer, 0.01, 10);
     writePos = 0;
     lfoPhase = 0.0f;
     feedbackL = feedbackR = 0.0f;
 }
 
-void PhaseDSP::reset()
+void PhaseDSP::resetState()
 {
-    EffectBase::reset();
-    std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-    std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
     lfoPhase = 0.0f;
     feedbackL = feedbackR = 0.0f;
 }
@@ -544,15 +609,16 @@ void PhaseDSP::process(float* leftChannel, float* rightChannel, int numSamples)
         // Modulated delay time
         float delayTime = lfo * maxDelay;
         float readPosF = writePos - delayTime - 1;
-        if (readPosF < 0) readPosF += delayBufferL.size();
+        if (readPosF < 0) readPosF += delayBuffer.size();
 
         int readPos = static_cast<int>(readPosF);
         float frac = readPosF - readPos;
-        int nextPos = (readPos + 1) % delayBufferL.size();
+        int nextPos = (readPos + 1) % delayBuffer.size();
 
         // Interpolated read
-        float wetL = delayBufferL[readPos] * (1.0f - frac) + delayBufferL[nextPos] * frac;
-        float wetR = delayBufferR[readPos] * (1.0f - frac) + delayBufferR[nextPos] * frac;
+        const StereoFrame wet = delayBuffer[readPos] * (1.0f - frac) + delayBuffer[nextPos] * frac;
+        float wetL = wet.left;
+        float wetR = wet.right;
 
         // Through-zero effect: subtract from dry for metallic sound
         float outL = dryL - wetL * 0.7f;
@@ -560,10 +626,9 @@ void PhaseDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 
         // Write with feedback
         float feedback = 0.5f + mixVal * 0.3f;
-        delayBufferL[writePos] = dryL + wetL * feedback;
-        delayBufferR[writePos] = dryR + wetR * feedback;
+        delayBuffer[writePos] = { dryL + wetL * feedback, dryR + wetR * feedback };
 
-        writePos = (writePos + 1) % delayBufferL.size();
+        writePos = (writePos + 1) % delayBuffer.size();
 
         leftChannel[i] = dryL + (outL - dryL) * mixVal;
         rightChannel[i] = dryR + (outR - dryR) * mixVal;
@@ -571,23 +636,26 @@ void PhaseDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 }
 
 // --- Prism: Comb Filter ---
+PrismDSP::PrismDSP()
+{
+    // Comb feedback reaches 0.85 at full mix over 7ms
+    tailLengthSeconds = feedbackDecaySeconds(0.007, 0.85);
+
+    addDelayBuffer(delayBuffer);
+}
+
 void PrismDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
 
     // Fixed comb delay ~7ms for hollow coloring
-    int delayLength = static_cast<int>(0.007 * sampleRate);
-    delayBufferL.resize(delayLength, 0.0f);
-    delayBufferR.resize(delayLength, 0.0f);
+    prepareDelayBuffer(delayBuffer, 0.007);
     writePos = 0;
     feedbackL = feedbackR = 0.0f;
 }
 
-void PrismDSP::reset()
+void PrismDSP::resetState()
 {
-    EffectBase::reset();
-    std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-    std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
     feedbackL = feedbackR = 0.0f;
 }
 
@@ -602,20 +670,17 @@ void PrismDSP::process(float* leftChannel, float* rightChannel, int numSamples)
         float dryR = rightChannel[i];
 
         // Read delayed signal
-        int readPos = writePos;
-        float delayedL = delayBufferL[readPos];
-        float delayedR = delayBufferR[readPos];
+        const StereoFrame delayed = delayBuffer[writePos];
 
         // Comb filter: output = input + delayed * feedback
         float feedback = 0.5f + mixVal * 0.35f;
-        float wetL = dryL + delayedL * feedback;
-        float wetR = dryR + delayedR * feedback;
+        float wetL = dryL + delayed.left * feedback;
+        float wetR = dryR + delayed.right * feedback;
 
         // Write to buffer
-        delayBufferL[writePos] = wetL;
-        delayBufferR[writePos] = wetR;
+        delayBuffer[writePos] = { wetL, wetR };
 
-        writePos = (writePos + 1) % delayBufferL.size();
+        writePos = (writePos + 1) % delayBuffer.size();
 
         leftChannel[i] = dryL + (wetL - dryL) * mixVal * 0.7f;
         rightChannel[i] = dryR + (wetR - dryR) * mixVal * 0.7f;
@@ -635,59 +700,34 @@ void ScorchDSP::prepare(const juce::dsp::ProcessSpec& spec)
 void ScorchDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 {
     for (int i = 0; i < numSamples; ++i)
-    {
-        float mixVal = mix.getNextValue();
-        if (mixVal < 0.001f) continue;
-
-        float dryL = leftChannel[i];
-        float dryR = rightChannel[i];
-
-        // Aggressive hard clipping with pre-gain
-        float gain = 1.0f + mixVal * 8.0f;
-        float wetL = dryL * gain;
-        float wetR = dryR * gain;
-
-        // Hard clip
-        wetL = std::max(-1.0f, std::min(1.0f, wetL));
-        wetR = std::max(-1.0f, std::min(1.0f, wetR));
+        processFrame(leftChannel[i], rightChannel[i]);
+}
 
-        // Rectification blend for brutal harmonics
-        float rectL = std::abs(wetL) * 0.3f;
-        float rectR = std::abs(wetR) * 0.3f;
-        wetL = wetL * 0.7f + rectL * mixVal;
-        wetR = wetR * 0.7f + rectR * mixVal;
+// --- Rust: Gated Reverb ---
+RustDSP::RustDSP()
+{
+    // Gated: the longest reflection plus the gate's release once input stops
+    tailLengthSeconds = 0.047 + 0.01;
 
-        leftChannel[i] = dryL + (wetL - dryL) * mixVal;
-        rightChannel[i] = dryR + (wetR - dryR) * mixVal;
-    }
+    addDelayBuffer(delayBuffer1);
+    addDelayBuffer(delayBuffer2);
 }
 
-// --- Rust: Gated Reverb ---
 void RustDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
 
     // Short reflections for industrial sound
-    int delay1 = static_cast<int>(0.023 * sampleRate);
-    int delay2 = static_cast<int>(0.047 * sampleRate);
-
-    delayBufferL1.resize(delay1, 0.0f);
-    delayBufferL2.resize(delay2, 0.0f);
-    delayBufferR1.resize(delay1, 0.0f);
-    delayBufferR2.resize(delay2, 0.0f);
+    prepareDelayBuffer(delayBuffer1, 0.023);
+    prepareDelayBuffer(delayBuffer2, 0.047);
 
     writePos1 = 0;
     writePos2 = 0;
     envelope = 0.0f;
 }
 
-void RustDSP::reset()
+void RustDSP::resetState()
 {
-    EffectBase::reset();
-    std::fill(delayBufferL1.begin(), delayBufferL1.end(), 0.0f);
-    std::fill(delayBufferL2.begin(), delayBufferL2.end(), 0.0f);
-    std::fill(delayBufferR1.begin(), delayBufferR1.end(), 0.0f);
-    std::fill(delayBufferR2.begin(), delayBufferR2.end(), 0.0f);
     envelope = 0.0f;
 }
 
@@ -713,23 +753,19 @@ void RustDSP::process(float* leftChannel, float* rightChannel, int numSamples)
         float gate = (envelope > 0.05f) ? 1.0f : envelope / 0.05f;
 
         // Read reflections
-        float tap1L = delayBufferL1[writePos1];
-        float tap2L = delayBufferL2[writePos2];
-        float tap1R = delayBufferR1[writePos1];
-        float tap2R = delayBufferR2[writePos2];
+        const StereoFrame tap1 = delayBuffer1[writePos1];
+        const StereoFrame tap2 = delayBuffer2[writePos2];
 
         // Harsh combination
-        float wetL = (tap1L * 0.7f + tap2L * 0.5f) * gate;
-        float wetR = (tap1R * 0.7f + tap2R * 0.5f) * gate;
+        float wetL = (tap1.left * 0.7f + tap2.left * 0.5f) * gate;
+        float wetR = (tap1.right * 0.7f + tap2.right * 0.5f) * gate;
 
         // Write with cross-feedback
-        delayBufferL1[writePos1] = dryL + tap2R * 0.3f * gate;
-        delayBufferL2[writePos2] = tap1L * 0.4f + dryL * 0.3f;
-        delayBufferR1[writePos1] = dryR + tap2L * 0.3f * gate;
-        delayBufferR2[writePos2] = tap1R * 0.4f + dryR * 0.3f;
+        delayBuffer1[writePos1] = { dryL + tap2.right * 0.3f * gate, dryR + tap2.left * 0.3f * gate };
+        delayBuffer2[writePos2] = { tap1.left * 0.4f + dryL * 0.3f, tap1.right * 0.4f + dryR * 0.3f };
 
-        writePos1 = (writePos1 + 1) % delayBufferL1.size();
-        writePos2 = (writePos2 + 1) % delayBufferL2.size();
+        writePos1 = (writePos1 + 1) % delayBuffer1.size();
+        writePos2 = (writePos2 + 1) % delayBuffer2.size();
 
         leftChannel[i] = dryL + wetL * mixVal;
         rightChannel[i] = dryR + wetR * mixVal;
@@ -737,25 +773,28 @@ void RustDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 }
 
 // --- Grind: Bitcrush Delay ---
+GrindDSP::GrindDSP()
+{
+    // Repeats every 300ms at 0.5 feedback
+    tailLengthSeconds = feedbackDecaySeconds(0.3, 0.5);
+
+    addDelayBuffer(delayBuffer);
+}
+
 void GrindDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
 
     // ~300ms delay
-    int delayLength = static_cast<int>(0.3 * sampleRate);
-    delayBufferL.resize(delayLength, 0.0f);
-    delayBufferR.resize(delayLength, 0.0f);
+    prepareDelayBuffer(delayBuffer, 0.3);
     writePos = 0;
     feedbackL = feedbackR = 0.0f;
     sampleHoldCounter = 0;
     heldSampleL = heldSampleR = 0.0f;
 }
 
-void GrindDSP::reset()
+void GrindDSP::resetState()
 {
-    EffectBase::reset();
-    std::fill(delayBufferL.begin(), delayBufferL.end(), 0.0f);
-    std::fill(delayBufferR.begin(), delayBufferR.end(), 0.0f);
     feedbackL = feedbackR = 0.0f;
     sampleHoldCounter = 0;
     heldSampleL = heldSampleR = 0.0f;
@@ -779,22 +818,19 @@ void GrindDSP::process(float* leftChannel, float* rightChannel, int numSamples)
             sampleHoldCounter = 0;
 
             // Read from delay
-            int readPos = writePos;
-            float delayedL = delayBufferL[readPos];
-            float delayedR = delayBufferR[readPos];
+            const StereoFrame delayed = delayBuffer[writePos];
 
             // Bit reduction
             float bits = 16.0f - mixVal * 12.0f;  // 16-bit to 4-bit
             float levels = std::pow(2.0f, bits);
-            heldSampleL = std::round(delayedL * levels) / levels;
-            heldSampleR = std::round(delayedR * levels) / levels;
+            heldSampleL = std::round(delayed.left * levels) / levels;
+            heldSampleR = std::round(delayed.right * levels) / levels;
         }
 
         // Write to delay with feedback
-        delayBufferL[writePos] = dryL + heldSampleL * 0.5f;
-        delayBufferR[writePos] = dryR + heldSampleR * 0.5f;
+        delayBuffer[writePos] = { dryL + heldSampleL * 0.5f, dryR + heldSampleR * 0.5f };
 
-        writePos = (writePos + 1) % delayBufferL.size();
+        writePos = (writePos + 1) % delayBuffer.size();
 
         leftChannel[i] = dryL + heldSampleL * mixVal;
         rightChannel[i] = dryR + heldSampleR * mixVal;
@@ -810,29 +846,8 @@ void ShredDSP::prepare(const juce::dsp::ProcessSpec& spec)
 
 void ShredDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 {
-    const float oscFreq = 200.0f;  // Hz - metallic frequency
-
     for (int i = 0; i < numSamples; ++i)
-    {
-        float mixVal = mix.getNextValue();
-        if (mixVal < 0.001f) continue;
-
-        float dryL = leftChannel[i];
-        float dryR = rightChannel[i];
-
-        // Mix-dependent frequency modulation
-        float freq = oscFreq + mixVal * 300.0f;  // 200Hz to 500Hz
-        float osc = std::sin(oscPhase * 2.0f * 3.14159f);
-        oscPhase += freq / sampleRate;
-        if (oscPhase >= 1.0f) oscPhase -= 1.0f;
-
-        // Ring modulate
-        float wetL = dryL * osc;
-        float wetR = dryR * osc;
-
-        leftChannel[i] = dryL + (wetL - dryL) * mixVal * 0.8f;
-        rightChannel[i] = dryR + (wetR - dryR) * mixVal * 0.8f;
-    }
+        processFrame(leftChannel[i], rightChannel[i]);
 }
 
 // --- Snarl: Aggressive Band-Pass ---
@@ -840,49 +855,17 @@ void SnarlDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     EffectBase::prepare(spec);
 
-    // Aggressive mid-focused band-pass
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, 1000.0f, 3.0f);
-    bpfL.coefficients = coeffs;
-    bpfR.coefficients = coeffs;
+    // Coefficients follow the mix, set on the first processed sample
+    filterMix = -1.0f;
 }
 
-void SnarlDSP::reset()
+void SnarlDSP::resetState()
 {
-    EffectBase::reset();
-    bpfL.reset();
-    bpfR.reset();
+    bpf.reset();
 }
 
 void SnarlDSP::process(float* leftChannel, float* rightChannel, int numSamples)
 {
-    // Calculate filter coefficients once per block using current mix value
-    float currentMix = mix.getCurrentValue();
-    if (currentMix >= 0.001f)
-    {
-        float freq = 800.0f + currentMix * 1200.0f;  // 800Hz to 2kHz
-        float q = 2.0f + currentMix * 4.0f;  // More aggressive resonance with mix
-        auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, freq, q);
-        *bpfL.coefficients = *coeffs;
-        *bpfR.coefficients = *coeffs;
-    }
-
     for (int i = 0; i < numSamples; ++i)
-    {
-        float mixVal = mix.getNextValue();
-        if (mixVal < 0.001f) continue;
-
-        float dryL = leftChannel[i];
-        float dryR = rightChannel[i];
-
-        float filteredL = bpfL.processSample(dryL);
-        float filteredR = bpfR.processSample(dryR);
-
-        // Add distortion to filtered signal
-        float gain = 1.0f + mixVal * 3.0f;
-        float wetL = std::tanh(filteredL * gain);
-        float wetR = std::tanh(filteredR * gain);
-
-        leftChannel[i] = dryL + wetL * mixVal;
-        rightChannel[i] = dryR + wetR * mixVal;
-    }
+        processFrame(leftChannel[i], rightChannel[i]);
 }
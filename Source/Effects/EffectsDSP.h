@@ -1,37 +1,244 @@
 #pragma once
 
 #include <juce_dsp/juce_dsp.h>
-#include <vector>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include "../DSP/Biquad.h"
+#include "../DSP/Svf.h"
+#include "../DSP/DelayBuffer.h"
+#include "../DSP/DspArena.h"
+#include "../DSP/DspTables.h"
+#include "../DSP/HalfBand.h"
 
 /**
  * Base class for all single-parameter effects
  * Each effect has only a Mix parameter (0.0 = dry, 1.0 = full wet)
+ *
+ * Delay memory is allocated lazily: effects register their DelayBuffers in
+ * their constructor and size them in prepare(), but the memory is only
+ * carved out of the owner's DspArena when the owner gives it to a whole
+ * preamp chain (PreampDSP::allocateEffectMemory). An effect that still finds
+ * itself without memory passes audio through untouched and requests it,
+ * as a last resort.
+ *
+ * Lifecycle (advanced once per block by beginProcessing()):
+ *   Active    - turned up, processed normally
+ *   FadingOut - turned down, processed until the mix has ramped to zero
+ *   Dormant   - not processed at all; its delay lines hold stale audio
+ *   Waking    - turned up again; the delay lines are cleared a slice per
+ *               block before it becomes Active, so no old feedback bursts
+ *               out and no single block pays for a full clear
  */
 class EffectBase
 {
 public:
     virtual ~EffectBase() = default;
 
+    // Delay memory is reserved for this rate on first prepare, so hosts that
+    // re-prepare for block size or layout changes never cause a reallocation
+    static constexpr double maxReservedSampleRate = 192000.0;
+
+    // Below this mix an effect is inaudible and skipped
+    static constexpr float activeMixThreshold = 0.001f;
+
     virtual void prepare(const juce::dsp::ProcessSpec& spec)
     {
         sampleRate = spec.sampleRate;
+        wetRateFactor = reducedRateWetPath ? HalfBandResampler::getRateFactorForSampleRate(sampleRate) : 1;
+        wetSampleRate = sampleRate / wetRateFactor;
         mix.reset(sampleRate, 0.02);  // 20ms smoothing
+        releaseDelayMemory();
+        lifecycle = isInUse() ? Lifecycle::Active : Lifecycle::Dormant;
     }
 
-    virtual void reset()
-    {
-        mix.reset(sampleRate, 0.02);
-    }
+    // Clears all state, delay lines included, in one go. Use from prepare /
+    // releaseResources; the audio thread wakes effects incrementally instead.
+    void reset();
 
     void setMix(float newMix) { mix.setTargetValue(newMix); }
 
-    // Process stereo buffer in-place
+    // Shared lookup tables (DSP/DspTables.h). Optional: without them tanh
+    // and sin are computed directly.
+    void setTables(const DspTables* newTables) noexcept { tables = newTables; }
+    bool isInUse() const { return mix.getTargetValue() >= activeMixThreshold; }
+
+    // How long the effect keeps ringing once its input goes silent, until it
+    // has decayed by tailDecayDb. 0 while the effect is not in use.
+    double getTailLengthSeconds() const { return isInUse() ? tailLengthSeconds : 0.0; }
+    double getMaxTailLengthSeconds() const { return tailLengthSeconds; }
+
+    // Level (relative to the input) at which a tail counts as gone
+    static constexpr double tailDecayDb = -100.0;
+
+    // Process stereo buffer in-place. PreampDSP calls this on the concrete
+    // (final) effect types through EffectChain, so the hot path is statically
+    // bound; the virtual is only the generic interface.
     virtual void process(float* leftChannel, float* rightChannel, int numSamples) = 0;
 
+    // Block-rate setup for effects that also offer a per-sample processFrame()
+    // (used when EffectChain fuses them into one loop). No-op by default.
+    void beginBlock() noexcept {}
+
+    // ======================================
+    // Lifecycle
+    // ======================================
+
+    enum class Lifecycle
+    {
+        Active,
+        FadingOut,
+        Dormant,
+        Waking
+    };
+
+    // Delay line frames cleared per block while Waking (64 KB)
+    static constexpr int flushFramesPerBlock = 8192;
+
+    // Audio thread, once per block before process() / processFrame().
+    // Advances the lifecycle and returns false if the effect is to be
+    // skipped for this block.
+    bool beginProcessing() noexcept
+    {
+        // Picked up here, so setTables() can come after prepare()
+        if (tables != nullptr)
+        {
+            tanhTable = tables->get(DspTableType::Tanh);
+            sineTable = tables->get(DspTableType::Sine);
+            cutoffTable = tables->get(DspTableType::CutoffGain, sampleRate);
+        }
+
+        switch (lifecycle)
+        {
+            case Lifecycle::Active:
+                if (! isInUse())
+                    lifecycle = Lifecycle::FadingOut;
+                return true;
+
+            case Lifecycle::FadingOut:
+                if (isInUse())
+                {
+                    lifecycle = Lifecycle::Active;
+                    return true;
+                }
+
+                if (mix.getCurrentValue() >= activeMixThreshold)
+                    return true;
+
+                enterDormant();
+                return false;
+
+            case Lifecycle::Dormant:
+                if (! isInUse())
+                    return false;
+
+                lifecycle = Lifecycle::Waking;
+                [[fallthrough]];
+
+            case Lifecycle::Waking:
+                if (! flushDelayBuffers())
+                    return false;
+
+                resetState();
+                lifecycle = Lifecycle::Active;
+                return true;
+        }
+
+        return true;
+    }
+
+    Lifecycle getLifecycle() const noexcept { return lifecycle; }
+
+    // Audio thread: the effect's chain has stopped being processed (preamp
+    // switch). It goes dormant with stale delay lines and its mix at zero,
+    // so it fades back in cleanly if the chain returns.
+    void suspend() noexcept;
+
+    // ======================================
+    // Lazy delay memory
+    // ======================================
+
+    // Audio thread, before process(): false while the effect has no delay
+    // memory. Flags a request once the effect is turned up.
+    bool ensureDelayMemory() noexcept
+    {
+        if (numDelayBuffers == 0 || delayMemoryReady.load(std::memory_order_acquire))
+            return true;
+
+        if (isInUse())
+            delayMemoryRequested.store(true, std::memory_order_release);
+
+        return false;
+    }
+
+    bool isDelayMemoryRequested() const { return delayMemoryRequested.load(std::memory_order_acquire); }
+    bool hasDelayMemory() const { return numDelayBuffers == 0 || delayMemoryReady.load(std::memory_order_acquire); }
+
+    // Arena bytes needed so any re-prepare up to maxReservedSampleRate fits
+    size_t getReservedDelayMemorySize() const;
+
+    // Carves this effect's delay buffers out of the arena (zeroed) and
+    // publishes them to the audio thread. Never call on the audio thread.
+    void allocateDelayMemory(DspArena& arena);
+
 protected:
+    // Registers a delay line for lazy allocation (call from the constructor)
+    void addDelayBuffer(DelayBuffer& buffer);
+
+    // Sizes a delay buffer to (seconds * wetSampleRate + extraSamples) frames
+    // and records what the same delay time needs at maxReservedSampleRate
+    void prepareDelayBuffer(DelayBuffer& buffer, double seconds, int extraSamples = 0);
+
+    // Effect state other than the delay lines and mix: filters, LFOs,
+    // envelopes. Must be cheap, it runs on the audio thread when waking.
+    virtual void resetState() {}
+
+    // Time for a feedback loop of loopSeconds with the given gain per pass
+    // to decay by tailDecayDb, including the first pass
+    static double feedbackDecaySeconds(double loopSeconds, double loopGain);
+
     double sampleRate = 44100.0;
     juce::SmoothedValue<float> mix;
+
+    // Effects whose wet path is band-limited far below 20kHz (reverbs, tape
+    // delays) set reducedRateWetPath in their constructor. At high sample
+    // rates their delay lines and wet filters then run at wetSampleRate,
+    // sampleRate / wetRateFactor, behind a HalfBandResampler.
+    bool reducedRateWetPath = false;
+    int wetRateFactor = 1;
+    double wetSampleRate = 44100.0;
+
+    // From the shared tables, refreshed each block; null without setTables()
+    const DspTables::Table* tanhTable = nullptr;
+    const DspTables::Table* sineTable = nullptr;
+    const DspTables::Table* cutoffTable = nullptr;  // For sampleRate
+    double tailLengthSeconds = 0.0;  // Set by effects that ring (see getTailLengthSeconds)
+
+private:
+    void releaseDelayMemory();
+
+    // Zeroes all registered delay lines, if they have memory yet
+    void clearDelayBuffers();
+
+    void enterDormant() noexcept;
+
+    // Clears the next flushFramesPerBlock frames of stale delay line
+    // content. Returns true once everything is clear.
+    bool flushDelayBuffers() noexcept;
+
+    static constexpr int maxDelayBuffers = 2;
+    std::array<DelayBuffer*, maxDelayBuffers> delayBuffers {};
+    int numDelayBuffers = 0;
+
+    std::atomic<bool> delayMemoryReady { false };
+    std::atomic<bool> delayMemoryRequested { false };
+
+    Lifecycle lifecycle = Lifecycle::Dormant;
+    bool delayBuffersStale = false;  // Dormant with old audio still in the lines
+    int flushBufferIndex = 0;        // Flush progress: buffer, then sample
+    int flushPosition = 0;
+
+    const DspTables* tables = nullptr;
 };
 
 // =============================================================================
@@ -42,15 +249,17 @@ protected:
  * Ember - Asymmetric tube saturation with even harmonics
  * Warm, musical breakup character
  */
-class EmberDSP : public EffectBase
+class EmberDSP final : public EffectBase
 {
 public:
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
+    void processFrame(float& left, float& right) noexcept;
 
 private:
-    float processSample(float input);
+    void resetState() override;
+
+    float processSample(float input) noexcept;
     float lastSampleL = 0.0f;
     float lastSampleR = 0.0f;
 };
@@ -59,18 +268,25 @@ private:
  * Haze - Dark plate reverb with rolled-off highs
  * Vintage spring-like warmth
  */
-class HazeDSP : public EffectBase
+class HazeDSP final : public EffectBase
 {
 public:
+    HazeDSP();
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
 
 private:
+    void resetState() override;
+
+    // One sample of the reverb at wetSampleRate
+    StereoFrame processWet(StereoFrame dry) noexcept;
+
+    HalfBandResampler resampler;
+
     // Simple comb filter delay lines for reverb
-    std::vector<float> delayBufferL1, delayBufferL2, delayBufferR1, delayBufferR2;
+    DelayBuffer delayBuffer1, delayBuffer2;
     int writePos1 = 0, writePos2 = 0;
-    juce::dsp::IIR::Filter<float> lpfL, lpfR;  // Darken filter
+    StereoBiquad lpf;  // Darken filter
     float feedbackL = 0.0f, feedbackR = 0.0f;
 };
 
@@ -78,18 +294,25 @@ private:
  * Echo - Tape delay emulation with wow/flutter
  * Organic, degrading repeats
  */
-class EchoDSP : public EffectBase
+class EchoDSP final : public EffectBase
 {
 public:
+    EchoDSP();
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
 
 private:
-    std::vector<float> delayBufferL, delayBufferR;
+    void resetState() override;
+
+    // One sample of the tape loop at wetSampleRate
+    StereoFrame processWet(StereoFrame dry) noexcept;
+
+    HalfBandResampler resampler;
+
+    DelayBuffer delayBuffer;
     int writePos = 0;
     float lfoPhase = 0.0f;
-    juce::dsp::IIR::Filter<float> lpfL, lpfR;  // Tape tone
+    StereoBiquad lpf;  // Tape tone
     float feedbackL = 0.0f, feedbackR = 0.0f;
 };
 
@@ -97,15 +320,17 @@ private:
  * Drift - Slow chorus with tape-style modulation
  * Subtle, dreamy movement
  */
-class DriftDSP : public EffectBase
+class DriftDSP final : public EffectBase
 {
 public:
+    DriftDSP();
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
 
 private:
-    std::vector<float> delayBufferL, delayBufferR;
+    void resetState() override;
+
+    DelayBuffer delayBuffer;
     int writePos = 0;
     float lfoPhase = 0.0f;
 };
@@ -114,15 +339,18 @@ private:
  * Velvet - Smooth low-pass filter with resonance
  * Silky, rounded tone
  */
-class VelvetDSP : public EffectBase
+class VelvetDSP final : public EffectBase
 {
 public:
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
+    void processFrame(float& left, float& right) noexcept;
 
 private:
-    juce::dsp::IIR::Filter<float> filterL, filterR;
+    void resetState() override;
+
+    StereoSvf filter;  // Cutoff and resonance swept by the mix, per sample
+    float filterMix = -1.0f;  // Mix the coefficients were last set for
 };
 
 // =============================================================================
@@ -133,45 +361,47 @@ private:
  * Fracture - Digital clipping with aliasing artifacts
  * Crisp, aggressive edge
  */
-class FractureDSP : public EffectBase
+class FractureDSP final : public EffectBase
 {
 public:
     void prepare(const juce::dsp::ProcessSpec& spec) override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
+    void processFrame(float& left, float& right) noexcept;
 };
 
 /**
  * Glisten - Shimmer reverb with pitch-shifted tails
  * Ethereal, crystalline space
  */
-class GlistenDSP : public EffectBase
+class GlistenDSP final : public EffectBase
 {
 public:
+    GlistenDSP();
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
 
 private:
-    std::vector<float> delayBufferL, delayBufferR;
-    std::vector<float> shimmerBufferL, shimmerBufferR;
+    void resetState() override;
+
+    DelayBuffer delayBuffer, shimmerBuffer;
     int writePos = 0, shimmerPos = 0;
     float shimmerPhase = 0.0f;
-    juce::dsp::IIR::Filter<float> hpfL, hpfR;  // Brighten filter
+    StereoBiquad hpf;  // Brighten filter
 };
 
 /**
  * Cascade - Multi-tap digital delay, pristine
  * Clean, rhythmic repeats
  */
-class CascadeDSP : public EffectBase
+class CascadeDSP final : public EffectBase
 {
 public:
+    CascadeDSP();
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
 
 private:
-    std::vector<float> delayBufferL, delayBufferR;
+    DelayBuffer delayBuffer;
     int writePos = 0;
     static constexpr int NUM_TAPS = 4;
     int tapDelays[NUM_TAPS] = {0, 0, 0, 0};
@@ -182,15 +412,17 @@ private:
  * Phase - Through-zero flanger, metallic
  * Sharp, jet-like sweep
  */
-class PhaseDSP : public EffectBase
+class PhaseDSP final : public EffectBase
 {
 public:
+    PhaseDSP();
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
 
 private:
-    std::vector<float> delayBufferL, delayBufferR;
+    void resetState() override;
+
+    DelayBuffer delayBuffer;
     int writePos = 0;
     float lfoPhase = 0.0f;
     float feedbackL = 0.0f, feedbackR = 0.0f;
@@ -200,15 +432,17 @@ private:
  * Prism - Comb filter with feedback
  * Hollow, resonant coloring
  */
-class PrismDSP : public EffectBase
+class PrismDSP final : public EffectBase
 {
 public:
+    PrismDSP();
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
 
 private:
-    std::vector<float> delayBufferL, delayBufferR;
+    void resetState() override;
+
+    DelayBuffer delayBuffer;
     int writePos = 0;
     float feedbackL = 0.0f, feedbackR = 0.0f;
 };
@@ -221,26 +455,29 @@ private:
  * Scorch - Hard clipping + rectification
  * Brutal, relentless drive
  */
-class ScorchDSP : public EffectBase
+class ScorchDSP final : public EffectBase
 {
 public:
     void prepare(const juce::dsp::ProcessSpec& spec) override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
+    void processFrame(float& left, float& right) noexcept;
 };
 
 /**
  * Rust - Gated reverb with harsh reflections
  * Industrial, punchy space
  */
-class RustDSP : public EffectBase
+class RustDSP final : public EffectBase
 {
 public:
+    RustDSP();
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
 
 private:
-    std::vector<float> delayBufferL1, delayBufferL2, delayBufferR1, delayBufferR2;
+    void resetState() override;
+
+    DelayBuffer delayBuffer1, delayBuffer2;
     int writePos1 = 0, writePos2 = 0;
     float envelope = 0.0f;
 };
@@ -249,15 +486,17 @@ private:
  * Grind - Bit-crushed delay with degradation
  * Lo-fi, destroyed repeats
  */
-class GrindDSP : public EffectBase
+class GrindDSP final : public EffectBase
 {
 public:
+    GrindDSP();
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
 
 private:
-    std::vector<float> delayBufferL, delayBufferR;
+    void resetState() override;
+
+    DelayBuffer delayBuffer;
     int writePos = 0;
     float feedbackL = 0.0f, feedbackR = 0.0f;
     int sampleHoldCounter = 0;
@@ -268,11 +507,12 @@ private:
  * Shred - Aggressive ring modulation blend
  * Metallic, inharmonic
  */
-class ShredDSP : public EffectBase
+class ShredDSP final : public EffectBase
 {
 public:
     void prepare(const juce::dsp::ProcessSpec& spec) override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
+    void processFrame(float& left, float& right) noexcept;
 
 private:
     float oscPhase = 0.0f;
@@ -282,13 +522,187 @@ private:
  * Snarl - Aggressive band-pass with distortion
  * Nasty, focused bite
  */
-class SnarlDSP : public EffectBase
+class SnarlDSP final : public EffectBase
 {
 public:
     void prepare(const juce::dsp::ProcessSpec& spec) override;
-    void reset() override;
     void process(float* leftChannel, float* rightChannel, int numSamples) override;
+    void processFrame(float& left, float& right) noexcept;
 
 private:
-    juce::dsp::IIR::Filter<float> bpfL, bpfR;
+    void resetState() override;
+
+    StereoSvf bpf;  // Centre and resonance swept by the mix, per sample
+    float filterMix = -1.0f;  // Mix the coefficients were last set for
 };
+
+// =============================================================================
+// Per-sample kernels
+// =============================================================================
+// Effects without delay memory expose their per-sample body inline, so that
+// EffectChain can fuse adjacent ones into a single loop (e.g. Ember into
+// Velvet) without a call per sample. Their process() is just this in a loop.
+
+inline float EmberDSP::processSample(float input) noexcept
+{
+    // Asymmetric tube-style saturation with even harmonics
+    float x = input * 2.0f;  // Boost into saturation
+
+    // Positive half: softer clipping (even harmonics)
+    if (x > 0.0f)
+    {
+        x = tanhLookup(tanhTable, x * 0.8f) * 1.1f;
+    }
+    // Negative half: harder clipping
+    else
+    {
+        x = tanhLookup(tanhTable, x * 1.2f);
+    }
+
+    return x * 0.7f;  // Output scaling
+}
+
+inline void EmberDSP::processFrame(float& left, float& right) noexcept
+{
+    float mixVal = mix.getNextValue();
+    if (mixVal < 0.001f) return;
+
+    float dryL = left;
+    float dryR = right;
+
+    // Add subtle low-pass smoothing for warmth
+    float wetL = processSample(dryL * 0.7f + lastSampleL * 0.3f);
+    float wetR = processSample(dryR * 0.7f + lastSampleR * 0.3f);
+
+    lastSampleL = dryL;
+    lastSampleR = dryR;
+
+    left = dryL + (wetL - dryL) * mixVal;
+    right = dryR + (wetR - dryR) * mixVal;
+}
+
+inline void VelvetDSP::processFrame(float& left, float& right) noexcept
+{
+    float mixVal = mix.getNextValue();
+    if (mixVal < 0.001f) return;
+
+    // Sweep the filter with the mix (only recalculated while it moves)
+    if (mixVal != filterMix)
+    {
+        float cutoff = 3000.0f - mixVal * 2000.0f;  // 3kHz to 1kHz
+        filter.setLowPass(cutoffGainLookup(cutoffTable, cutoff, sampleRate), 1.0f + mixVal * 0.5f);
+        filterMix = mixVal;
+    }
+
+    float dryL = left;
+    float dryR = right;
+
+    float wetL = filter.processLeft(dryL);
+    float wetR = filter.processRight(dryR);
+
+    left = dryL + (wetL - dryL) * mixVal;
+    right = dryR + (wetR - dryR) * mixVal;
+}
+
+inline void FractureDSP::processFrame(float& left, float& right) noexcept
+{
+    float mixVal = mix.getNextValue();
+    if (mixVal < 0.001f) return;
+
+    float dryL = left;
+    float dryR = right;
+
+    // Hard digital clipping with pre-gain based on mix
+    float gain = 1.0f + mixVal * 4.0f;
+    float wetL = std::max(-1.0f, std::min(1.0f, dryL * gain));
+    float wetR = std::max(-1.0f, std::min(1.0f, dryR * gain));
+
+    // Add subtle aliasing by quantizing
+    float bits = 12.0f - mixVal * 4.0f;  // 12-bit to 8-bit
+    float levels = std::pow(2.0f, bits);
+    wetL = std::round(wetL * levels) / levels;
+    wetR = std::round(wetR * levels) / levels;
+
+    left = dryL + (wetL - dryL) * mixVal;
+    right = dryR + (wetR - dryR) * mixVal;
+}
+
+inline void ScorchDSP::processFrame(float& left, float& right) noexcept
+{
+    float mixVal = mix.getNextValue();
+    if (mixVal < 0.001f) return;
+
+    float dryL = left;
+    float dryR = right;
+
+    // Aggressive hard clipping with pre-gain
+    float gain = 1.0f + mixVal * 8.0f;
+    float wetL = dryL * gain;
+    float wetR = dryR * gain;
+
+    // Hard clip
+    wetL = std::max(-1.0f, std::min(1.0f, wetL));
+    wetR = std::max(-1.0f, std::min(1.0f, wetR));
+
+    // Rectification blend for brutal harmonics
+    float rectL = std::abs(wetL) * 0.3f;
+    float rectR = std::abs(wetR) * 0.3f;
+    wetL = wetL * 0.7f + rectL * mixVal;
+    wetR = wetR * 0.7f + rectR * mixVal;
+
+    left = dryL + (wetL - dryL) * mixVal;
+    right = dryR + (wetR - dryR) * mixVal;
+}
+
+inline void ShredDSP::processFrame(float& left, float& right) noexcept
+{
+    constexpr float oscFreq = 200.0f;  // Hz - metallic frequency
+
+    float mixVal = mix.getNextValue();
+    if (mixVal < 0.001f) return;
+
+    float dryL = left;
+    float dryR = right;
+
+    // Mix-dependent frequency modulation
+    float freq = oscFreq + mixVal * 300.0f;  // 200Hz to 500Hz
+    float osc = sineLookup(sineTable, oscPhase);
+    oscPhase += freq / sampleRate;
+    if (oscPhase >= 1.0f) oscPhase -= 1.0f;
+
+    // Ring modulate
+    float wetL = dryL * osc;
+    float wetR = dryR * osc;
+
+    left = dryL + (wetL - dryL) * mixVal * 0.8f;
+    right = dryR + (wetR - dryR) * mixVal * 0.8f;
+}
+
+inline void SnarlDSP::processFrame(float& left, float& right) noexcept
+{
+    float mixVal = mix.getNextValue();
+    if (mixVal < 0.001f) return;
+
+    // Sweep the filter with the mix (only recalculated while it moves)
+    if (mixVal != filterMix)
+    {
+        float freq = 800.0f + mixVal * 1200.0f;  // 800Hz to 2kHz
+        float q = 2.0f + mixVal * 4.0f;  // More aggressive resonance with mix
+        bpf.setBandPass(cutoffGainLookup(cutoffTable, freq, sampleRate), q);
+        filterMix = mixVal;
+    }
+
+    float dryL = left;
+    float dryR = right;
+
+    float filteredL = bpf.processLeft(dryL);
+    float filteredR = bpf.processRight(dryR);
+
+    // Add distortion to filtered signal
+    float gain = 1.0f + mixVal * 3.0f;
+    float wetL = tanhLookup(tanhTable, filteredL * gain);
+    float wetR = tanhLookup(tanhTable, filteredR * gain);
+
+    left = dryL + wetL * mixVal;
+    right = dryR + wetR * mixVal;
+}
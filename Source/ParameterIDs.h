@@ -40,6 +40,13 @@ namespace ParameterIDs
     inline constexpr const char* steel_shred  = "steel_shred";  // Ring modulation
     inline constexpr const char* steel_snarl  = "steel_snarl";  // Aggressive band-pass
 
+    // Each preamp's effects, in ParameterSnapshot order
+    inline constexpr const char* effects[3][5] = {
+        { cath_ember, cath_haze, cath_echo, cath_drift, cath_velvet },
+        { fil_fracture, fil_glisten, fil_cascade, fil_phase, fil_prism },
+        { steel_scorch, steel_rust, steel_grind, steel_shred, steel_snarl }
+    };
+
     // State versioning for safe preset/session recall
     inline constexpr int kStateVersion = 3;  // Bumped for new effect params
 }
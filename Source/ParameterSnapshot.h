@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * ParameterSnapshot - Every parameter value the DSP reads, as one value
+ *
+ * The audio thread builds one of these per block, normally from the
+ * parameter atomics. While a preset is being applied it uses the preset's
+ * snapshot instead, so the whole preset takes effect on one block boundary
+ * rather than one parameter at a time.
+ */
+struct ParameterSnapshot
+{
+    static constexpr int numEffectsPerPreamp = 5;
+    using EffectMixes = std::array<float, numEffectsPerPreamp>;  // In ParameterIDs order
+
+    int preampType = 0;  // Choice index (0=Cathode, 1=Filament, 2=Steel Plate)
+    float drive = 0.25f;
+    float tone = 0.5f;
+    float output = 0.5f;
+
+    EffectMixes cathEffects {};
+    EffectMixes filEffects {};
+    EffectMixes steelEffects {};
+
+    EffectMixes& getEffects(int preamp) noexcept
+    {
+        return preamp == 1 ? filEffects : (preamp == 2 ? steelEffects : cathEffects);
+    }
+};
+
+/**
+ * SeqLockValue - Hands a trivially copyable value from one writer thread to
+ * its readers without locking
+ *
+ * The writer never waits. The reader never waits either: if it catches a
+ * write in progress, tryLoad() fails and the caller keeps what it had.
+ */
+template <typename Value>
+class SeqLockValue
+{
+public:
+    static_assert(std::is_trivially_copyable_v<Value>, "SeqLockValue copies bytes");
+
+    // Single writer
+    void store(const Value& value) noexcept
+    {
+        Words words {};
+        std::memcpy(words.data(), &value, sizeof(Value));
+
+        const auto seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);  // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < numWords; ++i)
+            storage[i].store(words[i], std::memory_order_relaxed);
+
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Any number of readers. Returns false (leaving value untouched) on a torn read.
+    bool tryLoad(Value& value) const noexcept
+    {
+        const auto before = sequence.load(std::memory_order_acquire);
+        if ((before & 1) != 0)
+            return false;
+
+        Words words;
+        for (size_t i = 0; i < numWords; ++i)
+            words[i] = storage[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before)
+            return false;
+
+        std::memcpy(&value, words.data(), sizeof(Value));
+        return true;
+    }
+
+private:
+    static constexpr size_t numWords = (sizeof(Value) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    using Words = std::array<uint32_t, numWords>;
+
+    std::atomic<uint32_t> sequence { 0 };
+    std::array<std::atomic<uint32_t>, numWords> storage {};
+};
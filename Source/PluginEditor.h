@@ -4,6 +4,8 @@
     Vintage preamp coloration utility
 
     Uses JUCE 8's native WebView relay system for bidirectional parameter sync.
+    The WebView itself belongs to the processor (see EditorWebView.h) and is
+    reused each time the editor opens.
   ==============================================================================
 */
 
@@ -12,6 +14,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_extra/juce_gui_extra.h>
 #include "PluginProcessor.h"
+#include "EditorWebView.h"
 
 //==============================================================================
 class DreDimuraEditor : public juce::AudioProcessorEditor,
@@ -29,84 +32,37 @@ private:
     //==============================================================================
     DreDimuraProcessor& processorRef;
 
-    //==============================================================================
-    // WebView component
-    std::unique_ptr<juce::WebBrowserComponent> webView;
-    juce::File resourcesDir;
-
-    //==============================================================================
-    // JUCE 8 Parameter Relays - MUST be created before WebView
-    std::unique_ptr<juce::WebSliderRelay> driveRelay;
-    std::unique_ptr<juce::WebSliderRelay> toneRelay;
-    std::unique_ptr<juce::WebSliderRelay> outputRelay;
-    std::unique_ptr<juce::WebToggleButtonRelay> bypassRelay;
-    std::unique_ptr<juce::WebComboBoxRelay> preampTypeRelay;
-
-    // Cathode effect relays
-    std::unique_ptr<juce::WebSliderRelay> cathEmberRelay;
-    std::unique_ptr<juce::WebSliderRelay> cathHazeRelay;
-    std::unique_ptr<juce::WebSliderRelay> cathEchoRelay;
-    std::unique_ptr<juce::WebSliderRelay> cathDriftRelay;
-    std::unique_ptr<juce::WebSliderRelay> cathVelvetRelay;
-
-    // Filament effect relays
-    std::unique_ptr<juce::WebSliderRelay> filFractureRelay;
-    std::unique_ptr<juce::WebSliderRelay> filGlistenRelay;
-    std::unique_ptr<juce::WebSliderRelay> filCascadeRelay;
-    std::unique_ptr<juce::WebSliderRelay> filPhaseRelay;
-    std::unique_ptr<juce::WebSliderRelay> filPrismRelay;
+    // When this editor started opening, for the time-to-first-frame
+    // measurement. Taken before the WebView may have to be created.
+    const double openStartMs;
 
-    // Steel Plate effect relays
-    std::unique_ptr<juce::WebSliderRelay> steelScorchRelay;
-    std::unique_ptr<juce::WebSliderRelay> steelRustRelay;
-    std::unique_ptr<juce::WebSliderRelay> steelGrindRelay;
-    std::unique_ptr<juce::WebSliderRelay> steelShredRelay;
-    std::unique_ptr<juce::WebSliderRelay> steelSnarlRelay;
+    // The processor's WebView, borrowed while this editor is open
+    EditorWebView& webView;
 
     //==============================================================================
-    // Parameter Attachments - created AFTER WebView
-    std::unique_ptr<juce::WebSliderParameterAttachment> driveAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> toneAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> outputAttachment;
-    std::unique_ptr<juce::WebToggleButtonParameterAttachment> bypassAttachment;
-    std::unique_ptr<juce::WebComboBoxParameterAttachment> preampTypeAttachment;
+    // Meters: [inL, inR, outL, outR] sent as a packed array of thousandths of
+    // full scale, and only when one has moved by more than the threshold.
+    // The rate drops while the editor is hidden or the signal is silent.
+    static constexpr int activeMeterRateHz = 30;
+    static constexpr int idleMeterRateHz = 10;
+    static constexpr int meterChangeThreshold = 2;  // Thousandths
+    static constexpr int meterSilenceLevel = 1;     // Thousandths
 
-    // Cathode effect attachments
-    std::unique_ptr<juce::WebSliderParameterAttachment> cathEmberAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> cathHazeAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> cathEchoAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> cathDriftAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> cathVelvetAttachment;
+    std::array<int, 4> sentMeterLevels { -1, -1, -1, -1 };
 
-    // Filament effect attachments
-    std::unique_ptr<juce::WebSliderParameterAttachment> filFractureAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> filGlistenAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> filCascadeAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> filPhaseAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> filPrismAttachment;
-
-    // Steel Plate effect attachments
-    std::unique_ptr<juce::WebSliderParameterAttachment> steelScorchAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> steelRustAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> steelGrindAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> steelShredAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> steelSnarlAttachment;
+    void setMeterRate(int rateHz);
 
     //==============================================================================
-    void setupWebView();
-    void setupRelays();
+    // Analysis: the feed runs only while the editor is showing, and its
+    // newest frame goes out (base64) at most once per timer tick
+    AnalysisFeed::Frame analysisFrame {};
+    uint32_t analysisFrameNumber = 0;
+
+    void sendAnalysisFrame();
 
-    //==============================================================================
     // Timer callback for meter updates
     void timerCallback() override;
 
-    //==============================================================================
-    // Activation handlers (always declared, conditionally implemented)
-    void sendActivationState();
-    void handleActivateLicense(const juce::var& data);
-    void handleDeactivateLicense(const juce::var& data);
-    void handleGetActivationStatus();
-
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DreDimuraEditor)
 };
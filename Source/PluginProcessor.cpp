@@ -8,12 +8,20 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+// How long after the first instance loads its editor WebView is pre-warmed,
+// leaving the host to finish loading the session first
+static constexpr int editorPrewarmDelayMs = 1500;
+
+// Numbers instances in the debug log
+static std::atomic<int> instancesCreated { 0 };
+
 //==============================================================================
 DreDimuraProcessor::DreDimuraProcessor()
     : AudioProcessor(BusesProperties()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
                      .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts(*this, nullptr, "Parameters", createParameterLayout())
+      apvts(*this, nullptr, "Parameters", createParameterLayout()),
+      instanceNumber(++instancesCreated)
 {
     // Cache parameter pointers for real-time access
     preampTypeParam = apvts.getRawParameterValue(ParameterIDs::preampType);
@@ -43,12 +51,30 @@ DreDimuraProcessor::DreDimuraProcessor()
     steelShredParam = apvts.getRawParameterValue(ParameterIDs::steel_shred);
     steelSnarlParam = apvts.getRawParameterValue(ParameterIDs::steel_snarl);
 
+    // No controller selects a preset until mapped
+    for (auto& preset : controllerPresets)
+        preset.store(-1);
+
+    apvts.addParameterListener(ParameterIDs::preampType, this);
+
     // Load BeatConnect configuration
     loadProjectData();
+
+    // Pre-warm the first instance's editor in the process. Later instances
+    // create theirs when first opened, so a large session doesn't start a
+    // browser per instance up front. Not for hosts without a plugin
+    // wrapper (e.g. the developer tools).
+    static std::atomic<bool> editorPrewarmed { false };
+
+    if (wrapperType != wrapperType_Undefined && ! editorPrewarmed.exchange(true))
+        startTimer(editorPrewarmDelayMs);
 }
 
 DreDimuraProcessor::~DreDimuraProcessor()
 {
+    apvts.removeParameterListener(ParameterIDs::preampType, this);
+    stopTimer();
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -301,17 +327,281 @@ const juce::String DreDimuraProcessor::getName() const
     return JucePlugin_Name;
 }
 
-bool DreDimuraProcessor::acceptsMidi() const { return false; }
+bool DreDimuraProcessor::acceptsMidi() const { return true; }
 bool DreDimuraProcessor::producesMidi() const { return false; }
 bool DreDimuraProcessor::isMidiEffect() const { return false; }
-double DreDimuraProcessor::getTailLengthSeconds() const { return 0.0; }
 
-int DreDimuraProcessor::getNumPrograms() { return 1; }
-int DreDimuraProcessor::getCurrentProgram() { return 0; }
-void DreDimuraProcessor::setCurrentProgram(int) {}
-const juce::String DreDimuraProcessor::getProgramName(int) { return {}; }
+double DreDimuraProcessor::getTailLengthSeconds() const
+{
+    // Worst case for the selected preamp rather than what is turned up right
+    // now: many hosts only ask once, and would cut off an effect raised later
+    return preampDSP.getMaxTailLengthSeconds(getSelectedPreampType());
+}
+
+int DreDimuraProcessor::getNumPrograms() { return juce::jmax(1, presetBank.size()); }
+int DreDimuraProcessor::getCurrentProgram() { return currentProgram.load(); }
+
+void DreDimuraProcessor::setCurrentProgram(int index)
+{
+    // Some hosts switch programs from their own threads
+    if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        applyPreset(index);
+    }
+    else
+    {
+        pendingProgram.store(index);
+        triggerAsyncUpdate();
+    }
+}
+
+const juce::String DreDimuraProcessor::getProgramName(int index)
+{
+    if (const auto* preset = presetBank.getPreset(index))
+        return preset->name;
+
+    return {};
+}
+
 void DreDimuraProcessor::changeProgramName(int, const juce::String&) {}
 
+//==============================================================================
+void DreDimuraProcessor::applyPreset(int index)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    TraceRecorder::Scope trace(*traceRecorder, TraceRecorder::message, "applyPreset", index);
+
+    const auto* preset = presetBank.getPreset(index);
+    if (preset == nullptr)
+        return;
+
+    const auto snapshot = preset->applyTo(getCurrentParameters());
+
+    // Memory for the preset's effects before the audio thread can see it
+    preampDSP.allocateEffectMemory(static_cast<PreampType>(snapshot.preampType));
+
+    // The audio thread switches to the whole preset from its next block...
+    presetSnapshot.store(snapshot);
+
+    const auto generation = presetGeneration.load(std::memory_order_relaxed);
+    presetGeneration.store(generation + 1, std::memory_order_relaxed);  // Odd: parameters changing
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // ...while the parameters are set one by one behind it
+    auto setParameter = [this](const char* parameterID, float value)
+    {
+        auto* parameter = apvts.getParameter(parameterID);
+        parameter->beginChangeGesture();
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        parameter->endChangeGesture();
+    };
+
+    setParameter(ParameterIDs::preampType, static_cast<float>(snapshot.preampType));
+    setParameter(ParameterIDs::drive, snapshot.drive);
+    setParameter(ParameterIDs::tone, snapshot.tone);
+    setParameter(ParameterIDs::output, snapshot.output);
+
+    const auto& ids = ParameterIDs::effects[preset->preampType];
+    for (size_t i = 0; i < preset->effects.size(); ++i)
+        setParameter(ids[i], preset->effects[i]);
+
+    // The parameters now hold the preset themselves
+    presetGeneration.store(generation + 2, std::memory_order_release);
+
+    currentProgram.store(index);
+    updateHostDisplay(ChangeDetails().withProgramChanged(true));
+}
+
+//==============================================================================
+void DreDimuraProcessor::setStageTimingEnabled(bool shouldBeEnabled)
+{
+    preampDSP.getStageProfiler().setEnabled(shouldBeEnabled);
+}
+
+bool DreDimuraProcessor::isStageTimingEnabled() const
+{
+    return preampDSP.getStageProfiler().isEnabled();
+}
+
+juce::var DreDimuraProcessor::getStageTimings() const
+{
+    const auto& profiler = preampDSP.getStageProfiler();
+
+    juce::Array<juce::var> bucketUpperNs;
+    for (int bucket = 0; bucket < StageProfiler::numBuckets; ++bucket)
+        bucketUpperNs.add(profiler.getBucketUpperNs(bucket));
+
+    juce::Array<juce::var> stages;
+    for (int stage = 0; stage < PreampDSP::numStages; ++stage)
+    {
+        const auto stats = profiler.getStats(stage);
+        if (stats.blocks == 0)
+            continue;
+
+        juce::Array<juce::var> histogram;
+        for (auto count : stats.histogram)
+            histogram.add(static_cast<juce::int64>(count));
+
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("name", PreampDSP::getStageName(stage));
+        entry->setProperty("blocks", static_cast<juce::int64>(stats.blocks));
+        entry->setProperty("meanNs", stats.meanNs);
+        entry->setProperty("maxNs", stats.maxNs);
+        entry->setProperty("histogram", histogram);
+        stages.add(juce::var(entry));
+    }
+
+    auto* timings = new juce::DynamicObject();
+    timings->setProperty("bucketUpperNs", bucketUpperNs);
+    timings->setProperty("stages", stages);
+    return juce::var(timings);
+}
+
+void DreDimuraProcessor::logDeadlineStats() const
+{
+    juce::Logger::writeToLog("Dre-Dimura #" + juce::String(instanceNumber) + " deadline: "
+                             + DeadlineMonitor::toString(getDeadlineStats()));
+}
+
+//==============================================================================
+bool DreDimuraProcessor::startCapture(const juce::File& file)
+{
+    if (isCapturing())
+        return true;
+
+    if (preparedSpec.sampleRate <= 0.0)
+        return false;
+
+    const auto captureFile = file != juce::File()
+        ? file
+        : CaptureRecorder::getCaptureDirectory()
+              .getChildFile(juce::Time::getCurrentTime().formatted("capture-%Y%m%d-%H%M%S") + ".ddcap")
+              .getNonexistentSibling();
+
+    // Prepare the DSP afresh, exactly as the replay will, with the audio
+    // thread held off until the capture is running
+    suspendProcessing(true);
+
+    const auto parameters = getBlockParameters();
+    preampDSP.setParameters(parameters);
+    preampDSP.prepare(preparedSpec);
+    silenceGate.reset();
+
+    const bool started = captureRecorder.start(captureFile, getCaptureFormat(parameters));
+
+    suspendProcessing(false);
+    return started;
+}
+
+void DreDimuraProcessor::stopCapture()
+{
+    if (! isCapturing())
+        return;
+
+    // Never while a block is half recorded
+    suspendProcessing(true);
+    captureRecorder.stop();
+    suspendProcessing(false);
+}
+
+CaptureFormat::FormatRecord DreDimuraProcessor::getCaptureFormat(const ParameterSnapshot& parameters) const
+{
+    CaptureFormat::FormatRecord format {};
+    format.sampleRate = preparedSpec.sampleRate;
+    format.maximumBlockSize = preparedSpec.maximumBlockSize;
+    format.numChannels = preparedSpec.numChannels;
+    format.effectAllocations = effectMemoryAllocations.load(std::memory_order_acquire);
+    format.chainsWithMemory = static_cast<uint32_t>(preampDSP.getChainsWithMemory());
+    format.parameters = parameters;
+    return format;
+}
+
+//==============================================================================
+void DreDimuraProcessor::setControllerPreset(int controller, int presetIndex)
+{
+    if (juce::isPositiveAndBelow(controller, static_cast<int>(controllerPresets.size())))
+        controllerPresets[static_cast<size_t>(controller)].store(presetBank.getPreset(presetIndex) != nullptr ? presetIndex : -1);
+}
+
+int DreDimuraProcessor::getControllerPreset(int controller) const
+{
+    if (juce::isPositiveAndBelow(controller, static_cast<int>(controllerPresets.size())))
+        return controllerPresets[static_cast<size_t>(controller)].load();
+
+    return -1;
+}
+
+juce::String DreDimuraProcessor::getControllerPresetMap() const
+{
+    juce::StringArray entries;
+
+    for (int controller = 0; controller < static_cast<int>(controllerPresets.size()); ++controller)
+        if (const auto* preset = presetBank.getPreset(getControllerPreset(controller)))
+            entries.add(juce::String(controller) + ":" + preset->id);
+
+    return entries.joinIntoString(",");
+}
+
+void DreDimuraProcessor::setControllerPresetMap(const juce::String& map)
+{
+    for (auto& preset : controllerPresets)
+        preset.store(-1);
+
+    // Presets are stored by id, so the map survives the bank being reordered
+    for (const auto& entry : juce::StringArray::fromTokens(map, ",", {}))
+        setControllerPreset(entry.upToFirstOccurrenceOf(":", false, false).getIntValue(),
+                            presetBank.indexOf(entry.fromFirstOccurrenceOf(":", false, false)));
+}
+
+int DreDimuraProcessor::getPresetForMidi(const juce::MidiMessageMetadata& metadata) const noexcept
+{
+    if (metadata.numBytes < 2)
+        return -1;
+
+    const auto status = metadata.data[0] & 0xf0;
+    const int number = metadata.data[1] & 0x7f;
+
+    if (status == 0xc0)
+        return number;
+
+    if (status == 0xb0 && metadata.numBytes >= 3 && metadata.data[2] >= 64)
+        return controllerPresets[static_cast<size_t>(number)].load(std::memory_order_relaxed);
+
+    return -1;
+}
+
+bool DreDimuraProcessor::switchPresetFromMidi(int index, ParameterSnapshot& parameters) noexcept
+{
+    const auto* preset = presetBank.getPreset(index);
+    if (preset == nullptr)
+        return false;
+
+    parameters = preset->applyTo(parameters);
+
+    midiSnapshot = parameters;
+    midiSnapshotActive = true;
+
+    midiProgram.store(index, std::memory_order_relaxed);
+    midiSwitchesRequested.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void DreDimuraProcessor::takeMidiPresetSwitches(const juce::MidiBuffer& midiMessages)
+{
+    auto parameters = getBlockParameters();
+    bool switched = false;
+
+    for (const auto metadata : midiMessages)
+    {
+        const int preset = getPresetForMidi(metadata);
+        if (preset >= 0)
+            switched |= switchPresetFromMidi(preset, parameters);
+    }
+
+    if (switched)
+        triggerAsyncUpdate();
+}
+
 //==============================================================================
 void DreDimuraProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
@@ -321,12 +611,32 @@ void DreDimuraProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock * 2);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
+    // Parameters first, so prepare() knows which preamp and effects are in use
+    const auto parameters = getBlockParameters();
+    preampDSP.setParameters(parameters);
     preampDSP.prepare(spec);
+    preparedSpec = spec;
+
+    // A MIDI program change or CC can select any preset at any time, and
+    // switches on the audio thread at its sample: every preamp the bank
+    // reaches needs its effects' memory before the first one arrives
+    preampDSP.allocateEffectMemory(PreampType::Cathode);
+    preampDSP.allocateEffectMemory(PreampType::Filament);
+    preampDSP.allocateEffectMemory(PreampType::SteelPlate);
+
+    silenceGate.prepare(sampleRate);
+    analysisFeed.prepare(sampleRate);
+    deadlineMonitor.prepare(sampleRate);
+    captureRecorder.prepare(getCaptureFormat(parameters));
 }
 
 void DreDimuraProcessor::releaseResources()
 {
     preampDSP.reset();
+    silenceGate.reset();
+
+    if (getDeadlineStats().blocks > 0)
+        logDeadlineStats();
 }
 
 bool DreDimuraProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
@@ -344,8 +654,15 @@ bool DreDimuraProcessor::isBusesLayoutSupported(const BusesLayout& layouts) cons
 void DreDimuraProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                        juce::MidiBuffer& midiMessages)
 {
-    juce::ignoreUnused(midiMessages);
     juce::ScopedNoDenormals noDenormals;
+    DeadlineMonitor::ScopedTimer deadlineTimer(deadlineMonitor, buffer.getNumSamples());
+    TraceRecorder::Scope trace(*traceRecorder, TraceRecorder::audio, "processBlock", buffer.getNumSamples());
+
+    // The previous block missed its deadline: keep the trace leading up to it
+    const auto deadlineMisses = deadlineMonitor.getMissCount();
+    if (deadlineMisses > deadlineMissesTraced)
+        traceRecorder->requestDump(true);
+    deadlineMissesTraced = deadlineMisses;
 
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -354,18 +671,36 @@ void DreDimuraProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
+    // Offline the audio thread can afford to allocate: a new preamp's
+    // effects get their memory before this block instead of after it
+    if (isNonRealtime())
+    {
+        preampDSP.allocateEffectMemory(static_cast<PreampType>(getBlockParameters().preampType));
+
+        if (preampDSP.allocateRequestedEffectMemory())
+            effectMemoryAllocations.fetch_add(1, std::memory_order_release);
+    }
+
+    // The block exactly as the DSP will see it, while capturing
+    captureRecorder.beginBlock(buffer, effectMemoryAllocations.load(std::memory_order_acquire),
+                               static_cast<uint32_t>(preampDSP.getChainsWithMemory()));
+
     // Measure input levels before processing
     const float decay = 0.9f;  // Smooth decay for meter ballistics
+    const auto& kernels = getDspKernels();
+    float inputPeak = 0.0f;
 
     if (totalNumInputChannels > 0)
     {
-        float peakL = buffer.getMagnitude(0, 0, buffer.getNumSamples());
+        float peakL = kernels.peakMagnitude(buffer.getReadPointer(0), buffer.getNumSamples());
         inputLevelL.store(std::max(peakL, inputLevelL.load() * decay));
+        inputPeak = std::max(inputPeak, peakL);
     }
     if (totalNumInputChannels > 1)
     {
-        float peakR = buffer.getMagnitude(1, 0, buffer.getNumSamples());
+        float peakR = kernels.peakMagnitude(buffer.getReadPointer(1), buffer.getNumSamples());
         inputLevelR.store(std::max(peakR, inputLevelR.load() * decay));
+        inputPeak = std::max(inputPeak, peakR);
     }
 
     // Check bypass
@@ -374,62 +709,212 @@ void DreDimuraProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     if (bypassed)
     {
         preampDSP.reset();  // Reset smoothed values to prevent clicks
+        silenceGate.reset();
+        takeMidiPresetSwitches(midiMessages);
+        captureRecorder.endBlock(CaptureFormat::bypassed, buffer);
         // Reset output meters when bypassed
         outputLevelL.store(outputLevelL.load() * decay);
         outputLevelR.store(outputLevelR.load() * decay);
         return;
     }
 
-    // Update DSP parameters
-    // AudioParameterChoice returns normalized 0-1 value, convert to index
-    int preampType = static_cast<int>(std::round(preampTypeParam->load() * 2.0f));
-    preampDSP.setPreampType(preampType);
-    preampDSP.setDrive(driveParam->load());
-    preampDSP.setTone(toneParam->load());
-    preampDSP.setOutputGain(outputParam->load());
-
-    // Update Cathode effect parameters (only processed when Cathode is active)
-    preampDSP.setCathEmber(cathEmberParam->load());
-    preampDSP.setCathHaze(cathHazeParam->load());
-    preampDSP.setCathEcho(cathEchoParam->load());
-    preampDSP.setCathDrift(cathDriftParam->load());
-    preampDSP.setCathVelvet(cathVelvetParam->load());
-
-    // Update Filament effect parameters
-    preampDSP.setFilFracture(filFractureParam->load());
-    preampDSP.setFilGlisten(filGlistenParam->load());
-    preampDSP.setFilCascade(filCascadeParam->load());
-    preampDSP.setFilPhase(filPhaseParam->load());
-    preampDSP.setFilPrism(filPrismParam->load());
-
-    // Update Steel Plate effect parameters
-    preampDSP.setSteelScorch(steelScorchParam->load());
-    preampDSP.setSteelRust(steelRustParam->load());
-    preampDSP.setSteelGrind(steelGrindParam->load());
-    preampDSP.setSteelShred(steelShredParam->load());
-    preampDSP.setSteelSnarl(steelSnarlParam->load());
-
-    // Process audio
+    // Silent input and every tail has rung out: output silence for free
+    // until signal returns. Parameters are picked up again on wake.
+    if (silenceGate.isAsleep(inputPeak, buffer.getNumSamples()))
+    {
+        takeMidiPresetSwitches(midiMessages);
+        buffer.clear();
+        captureRecorder.endBlock(CaptureFormat::asleep, buffer);
+        outputLevelL.store(outputLevelL.load() * decay);
+        outputLevelR.store(outputLevelR.load() * decay);
+        return;
+    }
+
+    auto parameters = getBlockParameters();
+    preampDSP.setParameters(parameters);
+    captureRecorder.addSegment(0, parameters);
+
+    // Process audio, split at each MIDI preset switch so the new preset
+    // starts at the event's own sample. The preamp crossfade and parameter
+    // smoothing make the switch click-free.
     juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    preampDSP.process(context);
+    const int numSamples = buffer.getNumSamples();
+
+    // First channel only, before and after: one copy each into the feed
+    analysisFeed.pushInput(buffer.getReadPointer(0), numSamples);
+    int processedUpTo = 0;
+    bool switched = false;
+
+    auto processUpTo = [&](int end)
+    {
+        if (end <= processedUpTo)
+            return;
+
+        auto subBlock = block.getSubBlock(static_cast<size_t>(processedUpTo),
+                                          static_cast<size_t>(end - processedUpTo));
+        juce::dsp::ProcessContextReplacing<float> context(subBlock);
+        preampDSP.process(context);
+        processedUpTo = end;
+    };
+
+    for (const auto metadata : midiMessages)
+    {
+        const int preset = getPresetForMidi(metadata);
+        if (preset < 0)
+            continue;
+
+        processUpTo(juce::jlimit(0, numSamples, metadata.samplePosition));
+
+        if (switchPresetFromMidi(preset, parameters))
+        {
+            traceRecorder->addInstant(TraceRecorder::audio, "midiPresetSwitch", preset);
+            preampDSP.setParameters(parameters);
+            captureRecorder.addSegment(processedUpTo, parameters);
+            switched = true;
+        }
+    }
+
+    processUpTo(numSamples);
+    analysisFeed.pushOutput(buffer.getReadPointer(0), numSamples);
+    captureRecorder.endBlock(CaptureFormat::processed, buffer);
+
+    // A preamp switch is waiting for its effects' memory - allocate it off
+    // the audio thread. A MIDI switch also needs the parameters brought in
+    // line there.
+    if (switched || preampDSP.hasPendingEffectMemoryRequests())
+        triggerAsyncUpdate();
 
     // Measure output levels after processing
+    float outputPeak = 0.0f;
+
     if (totalNumOutputChannels > 0)
     {
-        float peakL = buffer.getMagnitude(0, 0, buffer.getNumSamples());
+        float peakL = kernels.peakMagnitude(buffer.getReadPointer(0), buffer.getNumSamples());
         outputLevelL.store(std::max(peakL, outputLevelL.load() * decay));
+        outputPeak = std::max(outputPeak, peakL);
     }
     if (totalNumOutputChannels > 1)
     {
-        float peakR = buffer.getMagnitude(1, 0, buffer.getNumSamples());
+        float peakR = kernels.peakMagnitude(buffer.getReadPointer(1), buffer.getNumSamples());
         outputLevelR.store(std::max(peakR, outputLevelR.load() * decay));
+        outputPeak = std::max(outputPeak, peakR);
+    }
+
+    silenceGate.blockProcessed(outputPeak, preampDSP.getTailLengthSeconds());
+}
+
+PreampType DreDimuraProcessor::getSelectedPreampType() const
+{
+    return static_cast<PreampType>(getCurrentParameters().preampType);
+}
+
+ParameterSnapshot DreDimuraProcessor::getCurrentParameters() const
+{
+    ParameterSnapshot parameters;
+
+    // A choice parameter's raw value is its index
+    parameters.preampType = juce::jlimit(0, 2, juce::roundToInt(preampTypeParam->load()));
+    parameters.drive = driveParam->load();
+    parameters.tone = toneParam->load();
+    parameters.output = outputParam->load();
+
+    parameters.cathEffects = { cathEmberParam->load(), cathHazeParam->load(), cathEchoParam->load(),
+                               cathDriftParam->load(), cathVelvetParam->load() };
+    parameters.filEffects = { filFractureParam->load(), filGlistenParam->load(), filCascadeParam->load(),
+                              filPhaseParam->load(), filPrismParam->load() };
+    parameters.steelEffects = { steelScorchParam->load(), steelRustParam->load(), steelGrindParam->load(),
+                                steelShredParam->load(), steelSnarlParam->load() };
+
+    return parameters;
+}
+
+ParameterSnapshot DreDimuraProcessor::getBlockParameters()
+{
+    // A MIDI switch holds until the parameters have been set to its preset
+    if (midiSnapshotActive
+        && midiSwitchesApplied.load(std::memory_order_acquire) == midiSwitchesRequested.load(std::memory_order_relaxed))
+        midiSnapshotActive = false;
+
+    return midiSnapshotActive ? midiSnapshot : readParameters();
+}
+
+ParameterSnapshot DreDimuraProcessor::readParameters() const
+{
+    // The parameters are only read while no preset is being applied, and
+    // kept only if none started meanwhile (the generation didn't move).
+    // Otherwise the preset's snapshot is the whole of it. Either way a block
+    // never runs half of one preset and half of the next.
+    for (int attempt = 0; attempt < 3; ++attempt)
+    {
+        const auto generation = presetGeneration.load(std::memory_order_acquire);
+        ParameterSnapshot parameters;
+
+        if ((generation & 1) == 0)
+        {
+            parameters = getCurrentParameters();
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (presetGeneration.load(std::memory_order_relaxed) == generation)
+                return parameters;
+        }
+        else if (presetSnapshot.tryLoad(parameters))
+        {
+            return parameters;
+        }
     }
+
+    // Presets applied back to back throughout: as good as it gets
+    return getCurrentParameters();
+}
+
+void DreDimuraProcessor::parameterChanged(const juce::String&, float newValue)
+{
+    // Host automation can arrive on the audio thread: that switch waits for
+    // its own request instead
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        preampDSP.allocateEffectMemory(static_cast<PreampType>(juce::jlimit(0, 2, juce::roundToInt(newValue))));
+}
+
+void DreDimuraProcessor::handleAsyncUpdate()
+{
+    TraceRecorder::Scope trace(*traceRecorder, TraceRecorder::message, "handleAsyncUpdate");
+
+    if (preampDSP.allocateRequestedEffectMemory())
+        effectMemoryAllocations.fetch_add(1, std::memory_order_release);
+
+    const int program = pendingProgram.exchange(-1);
+    if (program >= 0)
+        applyPreset(program);
+
+    // A MIDI switch is already audible; bring the parameters in line. If
+    // another arrives meanwhile, its own update applies it again.
+    const auto midiRequest = midiSwitchesRequested.load(std::memory_order_acquire);
+    if (midiRequest != midiSwitchesApplied.load(std::memory_order_relaxed))
+    {
+        applyPreset(midiProgram.load(std::memory_order_relaxed));
+        midiSwitchesApplied.store(midiRequest, std::memory_order_release);
+    }
+}
+
+void DreDimuraProcessor::timerCallback()
+{
+    stopTimer();
+    getEditorWebView();
 }
 
 //==============================================================================
 bool DreDimuraProcessor::hasEditor() const { return true; }
 
+EditorWebView& DreDimuraProcessor::getEditorWebView()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (editorWebView == nullptr)
+        editorWebView = std::make_unique<EditorWebView>(*this);
+
+    return *editorWebView;
+}
+
 juce::AudioProcessorEditor* DreDimuraProcessor::createEditor()
 {
     return new DreDimuraEditor(*this);
@@ -442,6 +927,8 @@ void DreDimuraProcessor::getStateInformation(juce::MemoryBlock& destData)
 
     // Add version info for future compatibility
     state.setProperty("stateVersion", ParameterIDs::kStateVersion, nullptr);
+    state.setProperty("program", currentProgram.load(), nullptr);
+    state.setProperty("midiMap", getControllerPresetMap(), nullptr);
 
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
@@ -459,6 +946,9 @@ void DreDimuraProcessor::setStateInformation(const void* data, int sizeInBytes)
         int version = tree.getProperty("stateVersion", 0);
         juce::ignoreUnused(version);
 
+        // The parameters are restored as saved; the program is only a label
+        currentProgram.store(tree.getProperty("program", 0));
+        setControllerPresetMap(tree.getProperty("midiMap", "").toString());
         apvts.replaceState(tree);
     }
 }
@@ -14,6 +14,13 @@
 #include <juce_dsp/juce_dsp.h>
 #include "ParameterIDs.h"
 #include "PreampDSP.h"
+#include "PresetBank.h"
+#include "AnalysisFeed.h"
+#include "TraceRecorder.h"
+#include "CaptureRecorder.h"
+#include "DSP/DeadlineMonitor.h"
+#include "ParameterSnapshot.h"
+#include "DSP/SilenceGate.h"
 
 #if HAS_PROJECT_DATA
 #include "ProjectData.h"
@@ -24,7 +31,13 @@
 #endif
 
 //==============================================================================
-class DreDimuraProcessor : public juce::AudioProcessor
+class EditorWebView;
+
+//==============================================================================
+class DreDimuraProcessor : public juce::AudioProcessor,
+                           private juce::AudioProcessorValueTreeState::Listener,
+                           private juce::AsyncUpdater,
+                           private juce::Timer
 {
 public:
     //==============================================================================
@@ -44,6 +57,10 @@ public:
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
 
+    // The editor's WebView, created on first use and kept until the
+    // processor is destroyed (message thread)
+    EditorWebView& getEditorWebView();
+
     //==============================================================================
     const juce::String getName() const override;
 
@@ -67,6 +84,60 @@ public:
     // Parameter access
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
+    //==============================================================================
+    // Factory presets (also exposed to hosts as programs)
+    const PresetBank& getPresetBank() const noexcept { return presetBank; }
+
+    // Applies a whole preset at once: the audio thread switches to it on a
+    // single block boundary, while the parameters (and the host and UI)
+    // catch up behind it. Message thread.
+    void applyPreset(int index);
+
+    //==============================================================================
+    // Input/output audio for the editor's spectrum and transfer-curve view
+    AnalysisFeed& getAnalysisFeed() noexcept { return analysisFeed; }
+
+    //==============================================================================
+    // Per-stage DSP timing (see DSP/StageProfiler.h), off until enabled.
+    // Enabling starts the statistics afresh.
+    void setStageTimingEnabled(bool shouldBeEnabled);
+    bool isStageTimingEnabled() const;
+
+    // { bucketUpperNs: [..], stages: [{ name, blocks, meanNs, maxNs, histogram: [..] }] }
+    // for the stages that have run since timing was enabled
+    juce::var getStageTimings() const;
+
+    //==============================================================================
+    // processBlock duration against the real-time budget, for finding the
+    // instance that causes dropouts. Always recorded; reset() takes effect
+    // at the next block.
+    DeadlineMonitor::Stats getDeadlineStats() const { return deadlineMonitor.getStats(); }
+    void resetDeadlineStats() noexcept { deadlineMonitor.reset(); }
+
+    // Writes the deadline statistics, tagged with this instance's number,
+    // to the debug log
+    void logDeadlineStats() const;
+
+    // Process-wide event trace, off by default. While enabled, a missed
+    // deadline writes out the trace leading up to it.
+    TraceRecorder& getTraceRecorder() noexcept { return *traceRecorder; }
+
+    // Records every block's input, parameters and output hash for replay by
+    // Tools/CaptureReplay.cpp, off by default. Starting restarts the DSP from
+    // a clean state (one block of silence) so the replay can begin from the
+    // same one. Fails if the file can't be written or playback hasn't been
+    // prepared yet. Message thread.
+    bool startCapture(const juce::File& file = {});
+    void stopCapture();
+    bool isCapturing() const noexcept { return captureRecorder.isActive(); }
+
+    //==============================================================================
+    // MIDI preset switching, for live rigs. Program change N selects preset
+    // N; a controller mapped to a preset selects it on press (value >= 64).
+    // Either takes effect at the event's own sample, in the audio thread.
+    void setControllerPreset(int controller, int presetIndex);  // -1 unmaps
+    int getControllerPreset(int controller) const;
+
     //==============================================================================
     // BeatConnect Integration
     juce::String getPluginId() const { return pluginId_; }
@@ -89,10 +160,58 @@ private:
     // Load BeatConnect project data
     void loadProjectData();
 
+    // Preamp type currently selected by the parameter
+    PreampType getSelectedPreampType() const;
+
+    // Every DSP parameter, straight from the parameter atomics
+    ParameterSnapshot getCurrentParameters() const;
+
+    // What the DSP should run with this block: the preset being applied, if
+    // any, otherwise the current parameters (audio thread)
+    ParameterSnapshot readParameters() const;
+
+    // readParameters(), unless a MIDI preset switch is still waiting for
+    // the parameters to catch up with it (audio thread)
+    ParameterSnapshot getBlockParameters();
+
+    // What the DSP was last prepared with, for a capture
+    CaptureFormat::FormatRecord getCaptureFormat(const ParameterSnapshot& parameters) const;
+
+    // The preset a MIDI message selects, or -1 (audio thread)
+    int getPresetForMidi(const juce::MidiMessageMetadata& metadata) const noexcept;
+
+    // Switches parameters over to a preset from MIDI, and queues the same
+    // preset for the message thread to apply to the parameters themselves.
+    // Returns false for an index outside the bank (audio thread).
+    bool switchPresetFromMidi(int index, ParameterSnapshot& parameters) noexcept;
+
+    // Picks up MIDI preset switches in a block that isn't being processed
+    // (bypassed or asleep), where only the last one matters (audio thread)
+    void takeMidiPresetSwitches(const juce::MidiBuffer& midiMessages);
+
+    // MIDI controller <-> "midiMap" state property ("cc:presetId,...")
+    juce::String getControllerPresetMap() const;
+    void setControllerPresetMap(const juce::String& map);
+
+    // preampType: a new preamp selected on the message thread gets its
+    // memory here, so the audio thread's switch finds it ready
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    // Allocates effect memory requested by the audio thread, and applies
+    // programs selected off the message thread or by MIDI (message thread)
+    void handleAsyncUpdate() override;
+
+    // Pre-warms the editor WebView once the host has finished loading us
+    void timerCallback() override;
+
     //==============================================================================
     // Parameter tree
     juce::AudioProcessorValueTreeState apvts;
 
+    // Editor WebView, outliving editors (declared after apvts, since its
+    // parameter attachments must go first)
+    std::unique_ptr<EditorWebView> editorWebView;
+
     // Parameter pointers for real-time access
     std::atomic<float>* preampTypeParam = nullptr;
     std::atomic<float>* driveParam = nullptr;
@@ -125,6 +244,43 @@ private:
     // DSP
     PreampDSP preampDSP;
 
+    // Skips processing while the input is silent and all tails have decayed
+    SilenceGate silenceGate;
+
+    // Copies of the preamp's input and output for the editor's analysis
+    AnalysisFeed analysisFeed;
+
+    DeadlineMonitor deadlineMonitor;
+    const int instanceNumber;  // 1 for the first instance in the process, for the log
+
+    juce::SharedResourcePointer<TraceRecorder> traceRecorder;
+    uint64_t deadlineMissesTraced = 0;  // Audio thread
+
+    CaptureRecorder captureRecorder;
+    juce::dsp::ProcessSpec preparedSpec {};
+    std::atomic<uint32_t> effectMemoryAllocations { 0 };  // Replayed at the same block
+
+    //==============================================================================
+    // Presets
+    const PresetBank presetBank;
+
+    // The preset being applied, read by the audio thread instead of the
+    // parameters while presetGeneration is odd or moves under its read
+    SeqLockValue<ParameterSnapshot> presetSnapshot;
+    std::atomic<uint32_t> presetGeneration { 0 };
+
+    std::atomic<int> currentProgram { 0 };
+    std::atomic<int> pendingProgram { -1 };  // Selected off the message thread
+
+    // MIDI switches: the audio thread runs midiSnapshot from the event on,
+    // until the message thread has applied midiProgram to the parameters
+    std::array<std::atomic<int>, 128> controllerPresets;
+    ParameterSnapshot midiSnapshot;
+    bool midiSnapshotActive = false;
+    std::atomic<int> midiProgram { -1 };
+    std::atomic<uint32_t> midiSwitchesRequested { 0 };  // Written by the audio thread
+    std::atomic<uint32_t> midiSwitchesApplied { 0 };    // Written by the message thread
+
     //==============================================================================
     // Metering - atomic for thread-safe access from UI
     std::atomic<float> inputLevelL{ 0.0f };
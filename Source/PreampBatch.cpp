@@ -0,0 +1,433 @@
+#include "PreampBatch.h"
+
+// ======================================
+// Effects of one stream
+// ======================================
+// All three types' effects, as in PreampDSP, so the type can change on
+// reset(). Only the types selected since prepare() get memory, and only the
+// active one runs.
+struct PreampBatch::StreamEffects
+{
+    EmberDSP cathEmber; VelvetDSP cathVelvet; DriftDSP cathDrift; EchoDSP cathEcho; HazeDSP cathHaze;
+    FractureDSP filFracture; PrismDSP filPrism; PhaseDSP filPhase; CascadeDSP filCascade; GlistenDSP filGlisten;
+    ScorchDSP steelScorch; SnarlDSP steelSnarl; ShredDSP steelShred; GrindDSP steelGrind; RustDSP steelRust;
+
+    // Per preamp type, in ParameterSnapshot (ParameterIDs) order
+    const std::array<std::array<EffectBase*, ParameterSnapshot::numEffectsPerPreamp>, 3> effects {{
+        { &cathEmber, &cathHaze, &cathEcho, &cathDrift, &cathVelvet },
+        { &filFracture, &filGlisten, &filCascade, &filPhase, &filPrism },
+        { &steelScorch, &steelRust, &steelGrind, &steelShred, &steelSnarl }
+    }};
+
+    explicit StreamEffects(const DspTables* tables)
+    {
+        for (auto& chain : effects)
+            for (auto* effect : chain)
+                effect->setTables(tables);
+    }
+
+    void setMixes(const ParameterSnapshot& parameters)
+    {
+        const ParameterSnapshot::EffectMixes* mixes[] = { &parameters.cathEffects, &parameters.filEffects, &parameters.steelEffects };
+
+        for (size_t type = 0; type < effects.size(); ++type)
+            for (size_t i = 0; i < effects[type].size(); ++i)
+                effects[type][i]->setMix((*mixes[type])[i]);
+    }
+
+    // Mono, in place. Matches the composition in PreampDSP::processEffects().
+    bool process(PreampType type, float* channel, int numSamples)
+    {
+        switch (type)
+        {
+            case PreampType::Cathode:
+                return processEffectChain(channel, channel, numSamples,
+                                          fuse(cathEmber, cathVelvet), cathDrift, cathEcho, cathHaze);
+
+            case PreampType::Filament:
+                return processEffectChain(channel, channel, numSamples,
+                                          filFracture, filPrism, filPhase, filCascade, filGlisten);
+
+            case PreampType::SteelPlate:
+                return processEffectChain(channel, channel, numSamples,
+                                          fuse(steelScorch, steelSnarl, steelShred), steelGrind, steelRust);
+        }
+
+        return false;
+    }
+};
+
+// ======================================
+// Setup
+// ======================================
+PreampBatch::PreampBatch() = default;
+PreampBatch::~PreampBatch() = default;
+
+void PreampBatch::prepare(double newSampleRate, int maximumBlockSize, int newNumStreams)
+{
+    jassert(newNumStreams > 0 && newNumStreams <= maxStreams);
+
+    sampleRate = newSampleRate;
+    maxBlockSize = maximumBlockSize;
+    numStreams = juce::jlimit(0, maxStreams, newNumStreams);
+
+    getDspKernels();  // Selected now, as in PreampDSP::prepare()
+
+    parameterRamps.setSize(numParameterRamps, maxBlockSize, false, false, true);
+    toneCoefficients.resize(static_cast<size_t>(maxBlockSize));
+    laneBuffer.resize(static_cast<size_t>(maxBlockSize));
+
+    const auto width = Lanes::size();
+    groups.resize((static_cast<size_t>(numStreams) + width - 1) / width);
+
+    // Tone filter prewarp for this rate, built here if it isn't cached yet
+    sharedTables->request(DspTableType::CutoffGain, sampleRate);
+
+    // ======================================
+    // Effects
+    // ======================================
+    while (streamEffects.size() < static_cast<size_t>(numStreams))
+    {
+        streamEffects.push_back(std::make_unique<StreamEffects>(sharedTables.get()));
+        streamEffects.back()->setMixes(currentParameters);
+    }
+
+    streamEffects.resize(static_cast<size_t>(numStreams));
+
+    // Each stream is prepared as a mono PreampDSP would prepare its effects
+    const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(maxBlockSize), 1 };
+
+    for (auto& stream : streamEffects)
+        for (auto& chain : stream->effects)
+            for (auto* effect : chain)
+                effect->prepare(spec);
+
+    // Memory for every effect of the selected preamp, whatever its mix, as
+    // in PreampDSP::prepare(). Another type's effects get theirs from
+    // reset() when it is selected.
+    const auto activeType = static_cast<size_t>(pendingPreampType);
+
+    size_t bytesNeeded = 0;
+    for (auto& stream : streamEffects)
+        for (auto* effect : stream->effects[activeType])
+            bytesNeeded += effect->getReservedDelayMemorySize();
+
+    effectArena.prepare(bytesNeeded);
+    effectMemoryRequested = false;
+
+    reset();
+}
+
+void PreampBatch::reset()
+{
+    preampType = pendingPreampType;
+    updateVoicingEq();
+
+    // Not real-time, so the selected preamp's effects get their memory in line
+    for (auto& stream : streamEffects)
+        for (auto* effect : stream->effects[static_cast<size_t>(preampType)])
+            effect->allocateDelayMemory(effectArena);
+
+    std::fill(groups.begin(), groups.end(), LaneState {});
+
+    driveGain.reset(sampleRate, 0.02);  // 20ms smoothing, as in PreampDSP
+    toneValue.reset(sampleRate, 0.02);
+    outputGain.reset(sampleRate, 0.02);
+
+    for (auto& stream : streamEffects)
+        for (auto& chain : stream->effects)
+            for (auto* effect : chain)
+                effect->reset();
+}
+
+void PreampBatch::updateVoicingEq()
+{
+    PreampDSP::EqDesign design;
+    numEqSections = PreampDSP::designVoicingEq(preampType, sampleRate, design);
+
+    // Normalised exactly as StereoBiquad does it
+    for (size_t i = 0; i < static_cast<size_t>(numEqSections); ++i)
+    {
+        StereoBiquad section;
+        section.setCoefficients(design[i]);
+        eq[i] = { section.b0, section.b1, section.b2, section.a1, section.a2 };
+    }
+}
+
+void PreampBatch::setParameters(const ParameterSnapshot& parameters)
+{
+    currentParameters = parameters;
+
+    pendingPreampType = static_cast<PreampType>(juce::jlimit(0, 2, parameters.preampType));
+    driveGain.setTargetValue(parameters.drive);
+    toneValue.setTargetValue(parameters.tone);
+    outputGain.setTargetValue(PreampDSP::outputParameterToGain(parameters.output));
+
+    for (auto& stream : streamEffects)
+        stream->setMixes(parameters);
+}
+
+void PreampBatch::allocateRequestedEffectMemory()
+{
+    effectMemoryRequested = false;
+
+    for (auto& stream : streamEffects)
+        for (auto& chain : stream->effects)
+            for (auto* effect : chain)
+                if (effect->isDelayMemoryRequested())
+                    effect->allocateDelayMemory(effectArena);
+}
+
+// ======================================
+// Processing
+// ======================================
+void PreampBatch::process(const float* const* inputs, float* const* outputs, int numSamples)
+{
+    if (maxBlockSize == 0)
+    {
+        jassertfalse;  // prepare() hasn't been called
+        return;
+    }
+
+    const float* sliceInputs[maxStreams];
+    float* sliceOutputs[maxStreams];
+
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        for (int stream = 0; stream < numStreams; ++stream)
+        {
+            sliceInputs[stream] = inputs[stream] + start;
+            sliceOutputs[stream] = outputs[stream] + start;
+        }
+
+        processSlice(sliceInputs, sliceOutputs, juce::jmin(maxBlockSize, numSamples - start));
+    }
+}
+
+void PreampBatch::processSlice(const float* const* inputs, float* const* outputs, int numSamples)
+{
+    tanhTable = sharedTables->get(DspTableType::Tanh);
+    cutoffTable = sharedTables->get(DspTableType::CutoffGain, sampleRate);
+    fillParameterRamps(numSamples);
+
+    // Filament's shaper has no state, so it runs in the vectorised kernel a
+    // stream at a time, and the lanes pick up from its output
+    const float* const* sources = inputs;
+
+    if (preampType == PreampType::Filament)
+    {
+        const auto& kernels = getDspKernels();
+
+        for (int stream = 0; stream < numStreams; ++stream)
+            kernels.filamentShape(inputs[stream], parameterRamps.getReadPointer(driveRamp),
+                                  outputs[stream], numSamples);
+
+        sources = outputs;
+    }
+
+    // ======================================
+    // Preamp stage, a group of lanes at a time
+    // ======================================
+    const auto width = Lanes::size();
+    auto* interleaved = reinterpret_cast<float*>(laneBuffer.data());
+
+    for (size_t group = 0; group < groups.size(); ++group)
+    {
+        const auto firstStream = group * width;
+        const auto numLanes = juce::jmin(width, static_cast<size_t>(numStreams) - firstStream);
+
+        // Streams into lanes. Spare lanes run on silence and stay silent.
+        for (size_t i = 0; i < static_cast<size_t>(numSamples); ++i)
+            for (size_t lane = 0; lane < width; ++lane)
+                interleaved[i * width + lane] = lane < numLanes ? sources[firstStream + lane][i] : 0.0f;
+
+        switch (preampType)
+        {
+            case PreampType::Cathode:    processGroup<PreampType::Cathode>(group, numSamples);    break;
+            case PreampType::Filament:   processGroup<PreampType::Filament>(group, numSamples);   break;
+            case PreampType::SteelPlate: processGroup<PreampType::SteelPlate>(group, numSamples); break;
+        }
+
+        for (size_t i = 0; i < static_cast<size_t>(numSamples); ++i)
+            for (size_t lane = 0; lane < numLanes; ++lane)
+                outputs[firstStream + lane][i] = interleaved[i * width + lane];
+    }
+
+    // ======================================
+    // Effects, a stream at a time
+    // ======================================
+    bool waitingForMemory = false;
+
+    for (int stream = 0; stream < numStreams; ++stream)
+        waitingForMemory |= streamEffects[static_cast<size_t>(stream)]->process(preampType, outputs[stream], numSamples);
+
+    if (waitingForMemory)
+        effectMemoryRequested = true;
+}
+
+void PreampBatch::fillParameterRamps(int numSamples)
+{
+    juce::SmoothedValue<float>* smoothers[numParameterRamps] = { &driveGain, &toneValue, &outputGain };
+
+    for (int i = 0; i < numParameterRamps; ++i)
+    {
+        auto& smoother = *smoothers[i];
+        float* ramp = parameterRamps.getWritePointer(i);
+
+        if (smoother.isSmoothing())
+        {
+            for (int sample = 0; sample < numSamples; ++sample)
+                ramp[sample] = smoother.getNextValue();
+        }
+        else
+        {
+            juce::FloatVectorOperations::fill(ramp, smoother.getTargetValue(), numSamples);
+        }
+    }
+
+    // The tone filter is retuned whenever the tone moves, once for all lanes
+    const float* tones = parameterRamps.getReadPointer(toneRamp);
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        if (sample == 0 || tones[sample] != tones[sample - 1])
+            PreampDSP::tuneToneFilter(toneTuner, preampType, tones[sample], cutoffTable, sampleRate);
+
+        toneCoefficients[static_cast<size_t>(sample)] = { toneTuner.a1, toneTuner.a2, toneTuner.a3,
+                                                          toneTuner.m0, toneTuner.m1, toneTuner.m2 };
+    }
+}
+
+template <PreampType Type>
+void PreampBatch::processGroup(size_t group, int numSamples) noexcept
+{
+    // State in locals for the block, as in BiquadCascade
+    auto state = groups[group];
+    const auto sections = static_cast<size_t>(numEqSections);
+
+    const float* drives = parameterRamps.getReadPointer(driveRamp);
+    const float* gains = parameterRamps.getReadPointer(outputGainRamp);
+
+    for (size_t i = 0; i < static_cast<size_t>(numSamples); ++i)
+    {
+        Lanes x = laneBuffer[i];
+
+        if constexpr (Type == PreampType::Cathode)
+            x = shapeCathode(x, drives[i], state.cathBias, state.cathLastSample);
+        else if constexpr (Type == PreampType::SteelPlate)
+            x = shapeSteelPlate(x, drives[i], state.steelRectify);
+
+        // Tone filter (StereoSvf::tick)
+        const auto& tone = toneCoefficients[i];
+        const Lanes v3 = x - state.toneIc2;
+        const Lanes v1 = state.toneIc1 * tone.a1 + v3 * tone.a2;
+        const Lanes v2 = state.toneIc2 + state.toneIc1 * tone.a2 + v3 * tone.a3;
+        state.toneIc1 = v1 * 2.0f - state.toneIc1;
+        state.toneIc2 = v2 * 2.0f - state.toneIc2;
+        x = x * tone.m0 + v1 * tone.m1 + v2 * tone.m2;
+
+        // Voicing EQ and DC blocker (StereoBiquad, transposed direct form II)
+        for (size_t s = 0; s < sections; ++s)
+        {
+            const auto& c = eq[s];
+            const Lanes y = x * c.b0 + state.eqS1[s];
+            state.eqS1[s] = x * c.b1 - y * c.a1 + state.eqS2[s];
+            state.eqS2[s] = x * c.b2 - y * c.a2;
+            x = y;
+        }
+
+        laneBuffer[i] = x * gains[i];
+    }
+
+    groups[group] = state;
+}
+
+// ======================================
+// Shapers
+// ======================================
+// Branches become selects between both sides. Divisions by a constant are
+// multiplies here, so results can differ from PreampDSP in the last bit.
+
+PreampBatch::Lanes PreampBatch::shapeCathode(Lanes input, float drive, Lanes& bias, Lanes& lastSample) const noexcept
+{
+    const auto zero = Lanes::expand(0.0f);
+
+    const Lanes gained = input * (1.0f + drive * 2.5f);
+
+    // Slow bias drift
+    const Lanes biasTarget = gained * 0.1f;
+    bias = bias * 0.9995f + biasTarget * 0.0005f;
+    const Lanes biased = gained + bias * drive;
+
+    // Soft cubic into tanh above zero, harder tanh below
+    const auto positive = Lanes::greaterThan(biased, zero);
+    const Lanes soft = biased - biased * biased * biased * (1.0f / 3.0f);
+
+    Lanes saturated = tanhLanes(select(positive, soft * 0.8f, biased * 1.1f))
+                    * select(positive, Lanes::expand(1.1f), Lanes::expand(1.0f));
+
+    // Second harmonic
+    saturated = saturated + saturated * saturated * 0.15f * drive;
+
+    // Slew rate limiting
+    const float slewLimit = 0.3f + (1.0f - drive) * 0.7f;
+    const Lanes delta = saturated - lastSample;
+    const Lanes limited = lastSample + select(Lanes::greaterThan(delta, zero),
+                                              Lanes::expand(slewLimit), Lanes::expand(-slewLimit));
+
+    saturated = select(Lanes::greaterThan(Lanes::abs(delta), Lanes::expand(slewLimit)), limited, saturated);
+    lastSample = saturated;
+
+    return saturated * 0.8f;
+}
+
+PreampBatch::Lanes PreampBatch::shapeSteelPlate(Lanes input, float drive, Lanes& rectify) const noexcept
+{
+    const auto zero = Lanes::expand(0.0f);
+    const auto one = Lanes::expand(1.0f);
+    const auto minusOne = Lanes::expand(-1.0f);
+
+    const Lanes gained = input * (1.0f + drive * 4.0f);
+
+    // Rectification blend
+    const Lanes rectified = Lanes::abs(gained);
+    const float rectMix = drive * 0.25f;
+    const Lanes blended = gained * (1.0f - rectMix) + rectified * rectMix;
+
+    // Foldback into tanh above zero, harder tanh below
+    const auto positive = Lanes::greaterThan(blended, zero);
+    const Lanes folded = select(Lanes::greaterThan(blended, one), one - (blended - 1.0f) * 0.3f * drive, blended);
+
+    Lanes clipped = tanhLanes(select(positive, folded * 1.5f, blended * 2.0f))
+                  * select(positive, one, Lanes::expand(0.9f));
+
+    // Crossover dead zone
+    const float crossover = 0.02f * drive;
+
+    if (crossover > 0.0f)
+    {
+        const Lanes magnitude = Lanes::abs(clipped);
+        clipped = select(Lanes::lessThan(magnitude, Lanes::expand(crossover)),
+                         clipped * (magnitude * (1.0f / crossover)), clipped);
+    }
+
+    // Rectification grit
+    rectify = rectify * 0.95f + rectified * 0.05f;
+    const Lanes grit = rectify * drive * 0.1f;
+    clipped = clipped + grit * select(Lanes::greaterThan(clipped, zero), one, minusOne);
+
+    // Peak compression
+    const Lanes magnitude = Lanes::abs(clipped);
+    const Lanes compressed = select(Lanes::greaterThan(clipped, zero), one, minusOne) * ((magnitude - 0.8f) * 0.5f + 0.8f);
+    clipped = select(Lanes::greaterThan(magnitude, Lanes::expand(0.8f)), compressed, clipped);
+
+    return clipped * 0.75f;
+}
+
+PreampBatch::Lanes PreampBatch::tanhLanes(Lanes x) const noexcept
+{
+    for (size_t lane = 0; lane < Lanes::size(); ++lane)
+        x.set(lane, tanhLookup(tanhTable, x.get(lane)));
+
+    return x;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "PreampDSP.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+ * PreampBatch - Many independent mono streams through one preset at once
+ *
+ * For offline hosts rendering several mono sources with the same settings.
+ * Each stream sounds exactly as if it had its own mono PreampDSP (within
+ * float rounding), but the preamp stage runs one stream per SIMD lane
+ * (juce::dsp::SIMDRegister): the shaper, tone filter, voicing EQ, DC blocker
+ * and output gain of Lanes::size() streams cost about as much as one. The
+ * parameters are shared, so their smoothing, the tone filter retuning and
+ * every filter coefficient are computed once per sample for all streams;
+ * only the filter and shaper state is per lane.
+ *
+ * The shaper's tanh is read from the shared table one lane at a time, so
+ * it matches PreampDSP. Filament's stateless shaper already runs in the
+ * vectorised kernel (DSP/Kernels.h) a stream at a time.
+ *
+ * Each stream has its own effect chain, run a stream at a time: the
+ * effects' delay lines, resamplers and lifecycle stay as they are.
+ *
+ * Not thread-safe: set parameters and process from the same thread. The
+ * preamp type is picked up by prepare() and reset(), without a crossfade.
+ */
+class PreampBatch
+{
+public:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int maxStreams = 64;
+
+    PreampBatch();
+    ~PreampBatch();
+
+    void prepare(double newSampleRate, int maximumBlockSize, int newNumStreams);
+    void reset();
+
+    // Same mapping as PreampDSP::setParameters, for every stream
+    void setParameters(const ParameterSnapshot& parameters);
+
+    // One mono buffer per stream, numStreams of each. Input and output may
+    // be the same buffers.
+    void process(const float* const* inputs, float* const* outputs, int numSamples);
+
+    int getNumStreams() const noexcept { return numStreams; }
+    static constexpr int getLaneWidth() noexcept { return static_cast<int>(Lanes::size()); }
+
+    // See PreampDSP. The selected preamp's effects always have their memory,
+    // so this is only a last resort.
+    bool hasPendingEffectMemoryRequests() const noexcept { return effectMemoryRequested; }
+    void allocateRequestedEffectMemory();
+
+private:
+    // ======================================
+    // Processing
+    // ======================================
+
+    // At most one prepared block
+    void processSlice(const float* const* inputs, float* const* outputs, int numSamples);
+
+    // Advances the parameter smoothers by numSamples into parameterRamps,
+    // and the tone filter coefficients along with them
+    void fillParameterRamps(int numSamples);
+
+    // The active type's voicing EQ, for every lane
+    void updateVoicingEq();
+
+    // Shaper, tone filter, voicing EQ and output gain for one group of
+    // lanes, in place in laneBuffer
+    template <PreampType Type>
+    void processGroup(size_t group, int numSamples) noexcept;
+
+    // Lane versions of PreampDSP::processCathodeSample and
+    // processSteelPlateSample: keep them in step
+    Lanes shapeCathode(Lanes input, float drive, Lanes& bias, Lanes& lastSample) const noexcept;
+    Lanes shapeSteelPlate(Lanes input, float drive, Lanes& rectify) const noexcept;
+
+    Lanes tanhLanes(Lanes x) const noexcept;
+
+    // Bitwise pick from a where mask is set, b elsewhere
+    static Lanes select(Lanes::vMaskType mask, Lanes a, Lanes b) noexcept
+    {
+        return (a & mask) + (b & ~mask);
+    }
+
+    // ======================================
+    // State
+    // ======================================
+
+    PreampType preampType = PreampType::Cathode;
+    PreampType pendingPreampType = PreampType::Cathode;
+    double sampleRate = 44100.0;
+    int maxBlockSize = 0;
+    int numStreams = 0;
+
+    ParameterSnapshot currentParameters;  // Last set, for streams added by prepare()
+
+    juce::SmoothedValue<float> driveGain;
+    juce::SmoothedValue<float> toneValue;
+    juce::SmoothedValue<float> outputGain;
+
+    // The active type's filter coefficients, shared by every lane
+    struct ToneCoefficients
+    {
+        float a1, a2, a3, m0, m1, m2;
+    };
+
+    struct EqCoefficients
+    {
+        float b0, b1, b2, a1, a2;
+    };
+
+    // Per-sample parameter values for the current slice, as in PreampDSP
+    enum ParameterRamp { driveRamp, toneRamp, outputGainRamp, numParameterRamps };
+    juce::AudioBuffer<float> parameterRamps;
+
+    std::vector<ToneCoefficients> toneCoefficients;  // Per sample, retuned while the tone moves
+    StereoSvf toneTuner;
+
+    std::array<EqCoefficients, PreampDSP::maxEqSections> eq {};
+    int numEqSections = 0;
+
+    // Filter and shaper state of one group of Lanes::size() streams
+    struct LaneState
+    {
+        Lanes cathBias, cathLastSample, steelRectify;
+        Lanes toneIc1, toneIc2;
+        std::array<Lanes, PreampDSP::maxEqSections> eqS1, eqS2;
+    };
+
+    std::vector<LaneState> groups;
+    std::vector<Lanes> laneBuffer;  // One group's slice, a Lanes per sample
+
+    const DspTables::Table* tanhTable = nullptr;
+    const DspTables::Table* cutoffTable = nullptr;
+    juce::SharedResourcePointer<DspTables> sharedTables;
+
+    // ======================================
+    // Effects, one chain per stream
+    // ======================================
+
+    struct StreamEffects;
+    std::vector<std::unique_ptr<StreamEffects>> streamEffects;
+
+    DspArena effectArena;
+    bool effectMemoryRequested = false;
+
+    JUCE_DECLARE_NON_COPYABLE(PreampBatch)
+};
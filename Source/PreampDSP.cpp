@@ -2,88 +2,68 @@
 
 PreampDSP::PreampDSP()
 {
+    chainEffects[static_cast<size_t>(PreampType::Cathode)] = { &cathEmber, &cathVelvet, &cathDrift, &cathEcho, &cathHaze };
+    chainEffects[static_cast<size_t>(PreampType::Filament)] = { &filFracture, &filPrism, &filPhase, &filCascade, &filGlisten };
+    chainEffects[static_cast<size_t>(PreampType::SteelPlate)] = { &steelScorch, &steelSnarl, &steelShred, &steelGrind, &steelRust };
+
+    for (auto& effects : chainEffects)
+        for (auto* effect : effects)
+            effect->setTables(sharedTables.get());
 }
 
 void PreampDSP::prepare(const juce::dsp::ProcessSpec& spec)
 {
     sampleRate = spec.sampleRate;
 
+    // Pick the SIMD kernel variant here rather than in the first audio
+    // callback (environment lookup, CPUID, the debug-build validation pass)
+    getDspKernels();
+
+    // No fade across a prepare: start on the selected preamp
+    currentPreampType = pendingPreampType;
+    crossfadeSamplesRemaining = 0;
+    crossfadeLengthSamples = juce::roundToInt(sampleRate * crossfadeSeconds);
+    crossfadeBuffer.setSize(2, static_cast<int>(spec.maximumBlockSize), false, false, true);
+    parameterRamps.setSize(numParameterRamps, static_cast<int>(spec.maximumBlockSize), false, false, true);
+
     // Smoothed values for click-free parameter changes
     driveGain.reset(sampleRate, 0.02);  // 20ms smoothing
     toneValue.reset(sampleRate, 0.02);
     outputGain.reset(sampleRate, 0.02);
 
     // ======================================
-    // Cathode-specific filters (warm, vintage character)
-    // ======================================
-
-    // Main tone control
-    auto cathToneCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-        sampleRate, 1500.0f, 0.6f, 1.0f);
-    cathToneL.coefficients = cathToneCoeffs;
-    cathToneR.coefficients = cathToneCoeffs;
-
-    // Warmth: Low shelf boost at 120Hz for body
-    auto warmthCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-        sampleRate, 120.0f, 0.7f, 1.4f);  // +3dB low boost
-    cathWarmthL.coefficients = warmthCoeffs;
-    cathWarmthR.coefficients = warmthCoeffs;
-
-    // High rolloff: Gentle LP at 8kHz for vintage darkness
-    auto rolloffCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass(
-        sampleRate, 8000.0f, 0.5f);
-    cathRolloffL.coefficients = rolloffCoeffs;
-    cathRolloffR.coefficients = rolloffCoeffs;
-
-    // ======================================
-    // Filament-specific filters (cold, precise character)
+    // Preamp filters
     // ======================================
 
-    // Main tone control
-    auto filToneCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-        sampleRate, 4000.0f, 0.707f, 1.0f);
-    filToneL.coefficients = filToneCoeffs;
-    filToneR.coefficients = filToneCoeffs;
+    // Tone controls, at their centre until the first block retunes them
+    cathTone.setLowShelf(cutoffGainLookup(nullptr, 1500.0f, sampleRate), 0.6f, 1.0f);
+    filTone.setHighShelf(cutoffGainLookup(nullptr, 4000.0f, sampleRate), 0.707f, 1.0f);
+    steelTone.setBell(cutoffGainLookup(nullptr, 2500.0f, sampleRate), 1.5f, 1.0f);
 
-    // Presence: High shelf at 10kHz for crystalline shimmer
-    auto presenceCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-        sampleRate, 10000.0f, 0.707f, 1.3f);  // +2.5dB air
-    filPresenceL.coefficients = presenceCoeffs;
-    filPresenceR.coefficients = presenceCoeffs;
+    // Fixed voicing EQ, DC blocker last
+    EqDesign eq;
 
-    // ======================================
-    // Steel Plate-specific filters (aggressive character)
-    // ======================================
-
-    // Main tone control
-    auto steelToneCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-        sampleRate, 2500.0f, 1.5f, 1.0f);
-    steelToneL.coefficients = steelToneCoeffs;
-    steelToneR.coefficients = steelToneCoeffs;
+    auto setEq = [&](auto& cascade, PreampType type)
+    {
+        const auto numSections = static_cast<size_t>(designVoicingEq(type, sampleRate, eq));
+        jassert(numSections == cascade.sections.size());
 
-    // Mid scoop: Cut at 400Hz for that scooped metal tone
-    auto scoopCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-        sampleRate, 400.0f, 1.2f, 0.6f);  // -4dB mid cut
-    steelScoopL.coefficients = scoopCoeffs;
-    steelScoopR.coefficients = scoopCoeffs;
+        for (size_t i = 0; i < numSections; ++i)
+            cascade[i].setCoefficients(eq[i]);
+    };
 
-    // Harsh presence: Aggressive peak at 3.5kHz
-    auto harshCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-        sampleRate, 3500.0f, 2.0f, 1.8f);  // +5dB presence spike
-    steelPresenceL.coefficients = harshCoeffs;
-    steelPresenceR.coefficients = harshCoeffs;
-
-    // ======================================
-    // Shared: DC blocker
-    // ======================================
-    auto dcCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 10.0f);
-    dcBlockerL.coefficients = dcCoeffs;
-    dcBlockerR.coefficients = dcCoeffs;
+    setEq(cathEq, PreampType::Cathode);
+    setEq(filEq, PreampType::Filament);
+    setEq(steelEq, PreampType::SteelPlate);
 
     // ======================================
     // Prepare all effects
     // ======================================
 
+    // Tone filter and effect filter prewarp for this rate, built here if no
+    // instance has asked for this rate yet
+    sharedTables->request(DspTableType::CutoffGain, sampleRate);
+
     // Cathode effects
     cathEmber.prepare(spec);
     cathHaze.prepare(spec);
@@ -105,38 +85,50 @@ void PreampDSP::prepare(const juce::dsp::ProcessSpec& spec)
     steelShred.prepare(spec);
     steelSnarl.prepare(spec);
 
+    // ======================================
+    // Effect delay memory
+    // ======================================
+    // Every effect of the selected preamp gets memory now, whatever its mix,
+    // so turning one up later never waits. So does every chain that had
+    // memory before: the arena then stays the same size from one re-prepare
+    // to the next. A preamp that has never been selected costs nothing.
+    {
+        const juce::ScopedLock sl(effectArenaLock);
+
+        // The effects' prepare() above has released everything
+        const int chains = chainsWithMemory.exchange(0) | chainBit(currentPreampType);
+
+        size_t bytesNeeded = 0;
+        for (size_t type = 0; type < chainEffects.size(); ++type)
+            if ((chains & chainBit(static_cast<PreampType>(type))) != 0)
+                for (auto* effect : chainEffects[type])
+                    bytesNeeded += effect->getReservedDelayMemorySize();
+
+        effectArena.prepare(bytesNeeded);
+
+        for (size_t type = 0; type < chainEffects.size(); ++type)
+            if ((chains & chainBit(static_cast<PreampType>(type))) != 0)
+                allocateChainMemory(static_cast<PreampType>(type));
+
+        requestedChains.store(0, std::memory_order_relaxed);
+        effectMemoryRequested.store(false, std::memory_order_release);
+    }
+
     reset();
 }
 
 void PreampDSP::reset()
 {
-    // Reset all filters
-    cathToneL.reset();
-    cathToneR.reset();
-    cathWarmthL.reset();
-    cathWarmthR.reset();
-    cathRolloffL.reset();
-    cathRolloffR.reset();
-
-    filToneL.reset();
-    filToneR.reset();
-    filPresenceL.reset();
-    filPresenceR.reset();
-
-    steelToneL.reset();
-    steelToneR.reset();
-    steelScoopL.reset();
-    steelScoopR.reset();
-    steelPresenceL.reset();
-    steelPresenceR.reset();
-
-    dcBlockerL.reset();
-    dcBlockerR.reset();
-
-    // Reset state variables
-    cathLastSampleL = cathLastSampleR = 0.0f;
-    cathBiasL = cathBiasR = 0.0f;
-    steelRectifyL = steelRectifyR = 0.0f;
+    // Any pending switch just happens, once the new chain has its memory
+    // (until then the next block asks for it)
+    if (hasChainMemory(pendingPreampType))
+        currentPreampType = pendingPreampType;
+    crossfadeSamplesRemaining = 0;
+
+    // Reset all filters and state variables
+    resetPreampState(PreampType::Cathode);
+    resetPreampState(PreampType::Filament);
+    resetPreampState(PreampType::SteelPlate);
 
     // Reset smoothed values
     driveGain.reset(sampleRate, 0.02);
@@ -163,9 +155,194 @@ void PreampDSP::reset()
     steelSnarl.reset();
 }
 
+void PreampDSP::resetPreampState(PreampType type)
+{
+    switch (type)
+    {
+        case PreampType::Cathode:
+            cathTone.reset();
+            cathEq.reset();
+            cathLastSampleL = cathLastSampleR = 0.0f;
+            cathBiasL = cathBiasR = 0.0f;
+            break;
+
+        case PreampType::Filament:
+            filTone.reset();
+            filEq.reset();
+            break;
+
+        case PreampType::SteelPlate:
+            steelTone.reset();
+            steelEq.reset();
+            steelRectifyL = steelRectifyR = 0.0f;
+            break;
+    }
+}
+
+// ======================================
+// Preamp switching
+// ======================================
+void PreampDSP::beginPreampCrossfade()
+{
+    fadingPreampType = currentPreampType;
+    currentPreampType = pendingPreampType;
+
+    // The incoming preamp starts from silence rather than from wherever it
+    // was left. Its effects wake up on their own (see EffectBase lifecycle),
+    // flushing stale delay lines a slice at a time.
+    resetPreampState(currentPreampType);
+
+    crossfadeSamplesRemaining = crossfadeLengthSamples;
+
+    if (crossfadeSamplesRemaining == 0)
+        endPreampCrossfade();
+}
+
+void PreampDSP::applyPreampCrossfade(float* const* outputChannels, size_t numChannels, int numSamples)
+{
+    const int numToFade = juce::jmin(numSamples, crossfadeSamplesRemaining);
+    const int fadePosition = crossfadeLengthSamples - crossfadeSamplesRemaining;
+    const float angleStep = juce::MathConstants<float>::halfPi / static_cast<float>(crossfadeLengthSamples);
+
+    for (int i = 0; i < numToFade; ++i)
+    {
+        // Equal power: incoming rises along sin, outgoing falls along cos
+        const float angle = static_cast<float>(fadePosition + i + 1) * angleStep;
+        const float gainIn = std::sin(angle);
+        const float gainOut = std::cos(angle);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            const float* fading = crossfadeBuffer.getReadPointer(static_cast<int>(channel));
+            outputChannels[channel][i] = outputChannels[channel][i] * gainIn + fading[i] * gainOut;
+        }
+    }
+
+    crossfadeSamplesRemaining -= numToFade;
+
+    if (crossfadeSamplesRemaining == 0)
+        endPreampCrossfade();
+}
+
+void PreampDSP::endPreampCrossfade()
+{
+    crossfadeSamplesRemaining = 0;
+    suspendEffects(fadingPreampType);
+}
+
+void PreampDSP::suspendEffects(PreampType type)
+{
+    for (auto* effect : chainEffects[static_cast<size_t>(type)])
+        effect->suspend();
+}
+
+bool PreampDSP::allocateEffectMemory(PreampType type)
+{
+    const juce::ScopedLock sl(effectArenaLock);
+    return allocateChainMemory(type);
+}
+
+bool PreampDSP::allocateRequestedEffectMemory()
+{
+    const juce::ScopedLock sl(effectArenaLock);
+
+    effectMemoryRequested.store(false, std::memory_order_release);
+
+    bool allocated = false;
+    const int chains = requestedChains.exchange(0, std::memory_order_acquire);
+
+    for (size_t type = 0; type < chainEffects.size(); ++type)
+        if ((chains & chainBit(static_cast<PreampType>(type))) != 0)
+            allocated |= allocateChainMemory(static_cast<PreampType>(type));
+
+    // Last resort: a single effect found running without its memory
+    for (auto& effects : chainEffects)
+    {
+        for (auto* effect : effects)
+        {
+            if (effect->isDelayMemoryRequested())
+            {
+                effect->allocateDelayMemory(effectArena);
+                allocated = true;
+            }
+        }
+    }
+
+    return allocated;
+}
+
+bool PreampDSP::allocateChainMemory(PreampType type)
+{
+    if (hasChainMemory(type))
+        return false;
+
+    for (auto* effect : chainEffects[static_cast<size_t>(type)])
+        effect->allocateDelayMemory(effectArena);
+
+    chainsWithMemory.fetch_or(chainBit(type), std::memory_order_release);
+    return true;
+}
+
+size_t PreampDSP::getEffectMemoryBytesReserved() const
+{
+    const juce::ScopedLock sl(effectArenaLock);
+    return effectArena.getBytesReserved();
+}
+
+const char* PreampDSP::getStageName(int stage)
+{
+    // Matches the chain composition in processEffects()
+    static const char* const names[numStages] = {
+        "Cathode preamp", "Ember + Velvet", "Drift", "Echo", "Haze", "",
+        "Filament preamp", "Fracture", "Prism", "Phase", "Cascade", "Glisten",
+        "Steel Plate preamp", "Scorch + Snarl + Shred", "Grind", "Rust", "", ""
+    };
+
+    return juce::isPositiveAndBelow(stage, numStages) ? names[stage] : "";
+}
+
+double PreampDSP::getTailLengthSeconds() const
+{
+    // The effects run in series, so their tails add up
+    double tail = preampTailSeconds;
+    for (auto* effect : chainEffects[static_cast<size_t>(currentPreampType)])
+        tail += effect->getTailLengthSeconds();
+    return tail;
+}
+
+double PreampDSP::getMaxTailLengthSeconds(PreampType type) const
+{
+    double tail = preampTailSeconds;
+    for (auto* effect : chainEffects[static_cast<size_t>(type)])
+        tail += effect->getMaxTailLengthSeconds();
+    return tail;
+}
+
 void PreampDSP::setPreampType(int type)
 {
-    currentPreampType = static_cast<PreampType>(juce::jlimit(0, 2, type));
+    // Picked up (and crossfaded to) at the start of the next block
+    pendingPreampType = static_cast<PreampType>(juce::jlimit(0, 2, type));
+}
+
+void PreampDSP::fillParameterRamps(int numSamples)
+{
+    juce::SmoothedValue<float>* smoothers[numParameterRamps] = { &driveGain, &toneValue, &outputGain };
+
+    for (int i = 0; i < numParameterRamps; ++i)
+    {
+        auto& smoother = *smoothers[i];
+        float* ramp = parameterRamps.getWritePointer(i);
+
+        if (smoother.isSmoothing())
+        {
+            for (int sample = 0; sample < numSamples; ++sample)
+                ramp[sample] = smoother.getNextValue();
+        }
+        else
+        {
+            juce::FloatVectorOperations::fill(ramp, smoother.getTargetValue(), numSamples);
+        }
+    }
 }
 
 void PreampDSP::setDrive(float newDrive)
@@ -179,11 +356,91 @@ void PreampDSP::setTone(float newTone)
 }
 
 void PreampDSP::setOutputGain(float newOutput)
+{
+    outputGain.setTargetValue(outputParameterToGain(newOutput));
+}
+
+float PreampDSP::outputParameterToGain(float output) noexcept
 {
     // Convert 0-1 range to useful gain range (approximately -12dB to +6dB)
-    float gainDb = -12.0f + (newOutput * 18.0f);
-    float linearGain = juce::Decibels::decibelsToGain(gainDb);
-    outputGain.setTargetValue(linearGain);
+    float gainDb = -12.0f + (output * 18.0f);
+    return juce::Decibels::decibelsToGain(gainDb);
+}
+
+void PreampDSP::setToneFilter(PreampType type, float tone) noexcept
+{
+    switch (type)
+    {
+        case PreampType::Cathode:    tuneToneFilter(cathTone, type, tone, cutoffTable, sampleRate);  break;
+        case PreampType::Filament:   tuneToneFilter(filTone, type, tone, cutoffTable, sampleRate);   break;
+        case PreampType::SteelPlate: tuneToneFilter(steelTone, type, tone, cutoffTable, sampleRate); break;
+    }
+}
+
+void PreampDSP::tuneToneFilter(StereoSvf& filter, PreampType type, float tone,
+                               const DspTables::Table* cutoffTable, double sampleRate) noexcept
+{
+    switch (type)
+    {
+        case PreampType::Cathode:
+        {
+            float cutoff = 600.0f + (tone * 3000.0f);  // 600Hz to 3.6kHz - warmer range
+            filter.setLowShelf(cutoffGainLookup(cutoffTable, cutoff, sampleRate), 0.6f, 0.6f + tone * 0.8f);
+            break;
+        }
+        case PreampType::Filament:
+        {
+            // Precise, flat with shimmer
+            float cutoff = 1000.0f + (tone * 6000.0f);  // 1kHz to 7kHz - brighter range
+            filter.setHighShelf(cutoffGainLookup(cutoffTable, cutoff, sampleRate), 0.707f, 0.7f + tone * 0.6f);
+            break;
+        }
+        case PreampType::SteelPlate:
+        {
+            // Aggressive, scooped
+            float cutoff = 800.0f + (tone * 4000.0f);
+            filter.setBell(cutoffGainLookup(cutoffTable, cutoff, sampleRate), 1.5f, 0.5f + tone);
+            break;
+        }
+    }
+}
+
+int PreampDSP::designVoicingEq(PreampType type, double sampleRate, EqDesign& sections)
+{
+    using Coefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+
+    int numSections = 0;
+
+    switch (type)
+    {
+        case PreampType::Cathode:
+            // Warmth: Low shelf boost at 120Hz for body
+            sections[0] = Coefficients::makeLowShelf(sampleRate, 120.0f, 0.7f, 1.4f);  // +3dB low boost
+
+            // High rolloff: Gentle LP at 8kHz for vintage darkness
+            sections[1] = Coefficients::makeLowPass(sampleRate, 8000.0f, 0.5f);
+            numSections = 2;
+            break;
+
+        case PreampType::Filament:
+            // Presence: High shelf at 10kHz for crystalline shimmer
+            sections[0] = Coefficients::makeHighShelf(sampleRate, 10000.0f, 0.707f, 1.3f);  // +2.5dB air
+            numSections = 1;
+            break;
+
+        case PreampType::SteelPlate:
+            // Mid scoop: Cut at 400Hz for that scooped metal tone
+            sections[0] = Coefficients::makePeakFilter(sampleRate, 400.0f, 1.2f, 0.6f);  // -4dB mid cut
+
+            // Harsh presence: Aggressive peak at 3.5kHz
+            sections[1] = Coefficients::makePeakFilter(sampleRate, 3500.0f, 2.0f, 1.8f);  // +5dB presence spike
+            numSections = 2;
+            break;
+    }
+
+    // Shared: DC blocker, last in each type's EQ
+    sections[static_cast<size_t>(numSections)] = Coefficients::makeHighPass(sampleRate, 10.0f);
+    return numSections + 1;
 }
 
 // ======================================
@@ -214,12 +471,12 @@ float PreampDSP::processCathodeSample(float input, float drive)
         // Soft positive clipping with polynomial (even harmonics)
         float x = biased;
         saturated = x - (x * x * x / 3.0f);  // Soft cubic
-        saturated = std::tanh(saturated * 0.8f) * 1.1f;
+        saturated = tanhLookup(tanhTable, saturated * 0.8f) * 1.1f;
     }
     else
     {
         // Slightly harder negative clipping
-        saturated = std::tanh(biased * 1.1f);
+        saturated = tanhLookup(tanhTable, biased * 1.1f);
     }
 
     // Add subtle second harmonic (tube characteristic)
@@ -238,41 +495,6 @@ float PreampDSP::processCathodeSample(float input, float drive)
     return saturated * 0.8f;  // Output scaling
 }
 
-// ======================================
-// FILAMENT: Cold digital precision
-// ======================================
-// Character: Clean, precise, crystalline. Odd harmonics (3rd, 5th).
-// Symmetric clipping, fast transient response.
-// Mathematical precision, no warmth.
-float PreampDSP::processFilamentSample(float input, float drive)
-{
-    // Linear input gain (no coloration)
-    float gained = input * (1.0f + drive * 3.0f);
-
-    // Symmetric waveshaping with odd harmonics
-    // Chebyshev-style polynomial for clean odd harmonics
-    float x = gained;
-    float x2 = x * x;
-    float x3 = x2 * x;
-    float x5 = x3 * x2;
-
-    // Odd harmonic series: fundamental + 3rd + 5th
-    float shaped = x - (x3 * 0.2f * drive) + (x5 * 0.05f * drive);
-
-    // Hard limiter with slight knee (digital precision)
-    float threshold = 1.0f - drive * 0.3f;  // Lower threshold at high drive
-    if (std::abs(shaped) > threshold)
-    {
-        float excess = std::abs(shaped) - threshold;
-        float knee = threshold + excess * 0.3f;  // Slight softening at limit
-        shaped = (shaped > 0 ? 1.0f : -1.0f) * std::min(knee, 1.0f);
-    }
-
-    // No slew limiting - instant transient response
-
-    return shaped * 0.85f;
-}
-
 // ======================================
 // STEEL PLATE: Aggressive industrial saturation
 // ======================================
@@ -300,12 +522,12 @@ float PreampDSP::processSteelPlateSample(float input, float drive)
             float over = x - 1.0f;
             x = 1.0f - over * 0.3f * drive;  // Foldback distortion
         }
-        clipped = std::tanh(x * 1.5f);
+        clipped = tanhLookup(tanhTable, x * 1.5f);
     }
     else
     {
         // Negative: even harder, more aggressive
-        clipped = std::tanh(blended * 2.0f) * 0.9f;
+        clipped = tanhLookup(tanhTable, blended * 2.0f) * 0.9f;
     }
 
     // Add grit: subtle crossover distortion simulation
@@ -356,3 +578,30 @@ void PreampDSP::setSteelRust(float mix) { steelRust.setMix(mix); }
 void PreampDSP::setSteelGrind(float mix) { steelGrind.setMix(mix); }
 void PreampDSP::setSteelShred(float mix) { steelShred.setMix(mix); }
 void PreampDSP::setSteelSnarl(float mix) { steelSnarl.setMix(mix); }
+
+void PreampDSP::setParameters(const ParameterSnapshot& parameters)
+{
+    setPreampType(parameters.preampType);
+    setDrive(parameters.drive);
+    setTone(parameters.tone);
+    setOutputGain(parameters.output);
+
+    // Each preamp's effects are only processed while it is active
+    setCathEmber(parameters.cathEffects[0]);
+    setCathHaze(parameters.cathEffects[1]);
+    setCathEcho(parameters.cathEffects[2]);
+    setCathDrift(parameters.cathEffects[3]);
+    setCathVelvet(parameters.cathEffects[4]);
+
+    setFilFracture(parameters.filEffects[0]);
+    setFilGlisten(parameters.filEffects[1]);
+    setFilCascade(parameters.filEffects[2]);
+    setFilPhase(parameters.filEffects[3]);
+    setFilPrism(parameters.filEffects[4]);
+
+    setSteelScorch(parameters.steelEffects[0]);
+    setSteelRust(parameters.steelEffects[1]);
+    setSteelGrind(parameters.steelEffects[2]);
+    setSteelShred(parameters.steelEffects[3]);
+    setSteelSnarl(parameters.steelEffects[4]);
+}
@@ -2,6 +2,12 @@
 
 #include <juce_dsp/juce_dsp.h>
 #include "Effects/EffectsDSP.h"
+#include "Effects/EffectChain.h"
+#include "DSP/BiquadCascade.h"
+#include "DSP/DspTables.h"
+#include "DSP/Svf.h"
+#include "DSP/Kernels.h"
+#include "ParameterSnapshot.h"
 
 /**
  * PreampDSP - Three distinct preamp characters
@@ -72,39 +78,184 @@ public:
     void setSteelShred(float mix);
     void setSteelSnarl(float mix);
 
+    // Every setter above at once, from one snapshot
+    void setParameters(const ParameterSnapshot& parameters);
+
+    // ======================================
+    // Tail length
+    // ======================================
+
+    // How long the output keeps ringing after the input goes silent, for the
+    // active preamp with the effects that are currently turned up
+    double getTailLengthSeconds() const;
+
+    // Worst case for a preamp type: every one of its effects turned up.
+    // Only depends on constants, so it is safe to call from any thread.
+    double getMaxTailLengthSeconds(PreampType type) const;
+
+    // Settling time of the preamp's own filters to decay by
+    // EffectBase::tailDecayDb. The 10Hz DC blocker (second order, Q = 1/sqrt 2)
+    // is the slowest: its envelope falls at w0 / 2Q = 44.4/s, and 100dB is
+    // ln(1e5) / 44.4 = 0.26s.
+    static constexpr double preampTailSeconds = 0.26;
+
+    // ======================================
+    // Lazy effect memory
+    // ======================================
+    // Delay memory is given a whole preamp chain at a time: prepare() does
+    // the selected preamp's, and a preamp type switch waits until the
+    // incoming chain has its memory. Call allocateEffectMemory() for the new
+    // type before the DSP sees it, so the switch never has to wait.
+
+    // Gives every effect of a preamp its delay memory, whatever its mix.
+    // Message thread, or the audio thread when rendering offline. Returns
+    // true if anything was allocated.
+    bool allocateEffectMemory(PreampType type);
+
+    // True once the audio thread is waiting for memory: a switch to a preamp
+    // whose chain has none yet. The owner should then call
+    // allocateRequestedEffectMemory() from the message thread.
+    bool hasPendingEffectMemoryRequests() const { return effectMemoryRequested.load(std::memory_order_acquire); }
+    bool allocateRequestedEffectMemory();
+
+    // Bit (1 << type) per preamp type whose effects all have their memory
+    int getChainsWithMemory() const noexcept { return chainsWithMemory.load(std::memory_order_acquire); }
+
+    size_t getEffectMemoryBytesReserved() const;
+
+    // ======================================
+    // Stage timing
+    // ======================================
+    // One profiler stage per preamp and per effect chain stage, for each
+    // preamp type (see getStageIndex). Off until enabled.
+
+    static constexpr int stagesPerPreamp = 6;
+    static constexpr int numStages = 3 * stagesPerPreamp;
+
+    // position 0 is the preamp itself, 1 onwards its effect chain's stages
+    static int getStageIndex(PreampType type, int position) noexcept
+    {
+        return static_cast<int>(type) * stagesPerPreamp + position;
+    }
+
+    // Empty for the unused slots of shorter chains
+    static const char* getStageName(int stage);
+
+    StageProfiler& getStageProfiler() noexcept { return stageProfiler; }
+    const StageProfiler& getStageProfiler() const noexcept { return stageProfiler; }
+
+    // ======================================
+    // Voicing
+    // ======================================
+    // The fixed filter designs and parameter mappings, shared with
+    // PreampBatch so that it sounds the same as this class.
+
+    // A type's voicing EQ sections, {b0, b1, b2, a0, a1, a2} each as from
+    // IIR::ArrayCoefficients, with the DC blocker last. Returns how many.
+    static constexpr int maxEqSections = 3;
+    using EqDesign = std::array<std::array<float, 6>, maxEqSections>;
+    static int designVoicingEq(PreampType type, double sampleRate, EqDesign& sections);
+
+    // Tunes a type's tone filter for a tone value (0-1)
+    static void tuneToneFilter(StereoSvf& filter, PreampType type, float tone,
+                               const DspTables::Table* cutoffTable, double sampleRate) noexcept;
+
+    // Output parameter (0-1) to linear gain
+    static float outputParameterToGain(float output) noexcept;
+
 private:
+    // ======================================
+    // Processing stages
+    // ======================================
+
+    // Everything process() does, for at most one prepared block of samples
+    template <typename InputBlock, typename OutputBlock>
+    void processSlice(const InputBlock& inputBlock, const OutputBlock& outputBlock);
+
+    // Advances the parameter smoothers by numSamples into parameterRamps
+    void fillParameterRamps(int numSamples);
+
+    // Saturation, tone shaping and output gain for one preamp type, from the
+    // input block into outputChannels, following parameterRamps
+    template <typename InputBlock>
+    void processPreamp(PreampType type, const InputBlock& inputBlock,
+                       float* const* outputChannels, size_t numChannels, size_t numSamples);
+
+    // One preamp's effect chain, in place. Returns true if an effect is
+    // waiting for its delay memory.
+    bool processEffects(PreampType type, float* leftChannel, float* rightChannel, int numSamples);
+
+    // ======================================
+    // Preamp switching
+    // ======================================
+    // A new preamp type fades in over crossfadeSeconds (equal power) while
+    // the old one fades out. Only during that window do both chains run.
+
+    void beginPreampCrossfade();
+    void applyPreampCrossfade(float* const* outputChannels, size_t numChannels, int numSamples);
+    void endPreampCrossfade();
+
+    // Filters and saturation state of one preamp back to silence
+    void resetPreampState(PreampType type);
+
+    // Puts a chain's effects to sleep once it is no longer processed
+    void suspendEffects(PreampType type);
+
+    static constexpr double crossfadeSeconds = 0.005;
+
     // ======================================
     // Preamp-specific saturation algorithms
     // ======================================
+    // PreampBatch has lane versions of the Cathode and Steel Plate shapers:
+    // keep them in step.
 
     // Cathode: Warm tube saturation with even harmonics
     float processCathodeSample(float input, float drive);
 
-    // Filament: Clean digital precision with odd harmonics
-    float processFilamentSample(float input, float drive);
+    // Filament: Clean digital precision with odd harmonics. Stateless, so it
+    // runs a block at a time as DspKernels::filamentShape (DSP/Kernels.cpp).
 
     // Steel Plate: Aggressive industrial saturation
     float processSteelPlateSample(float input, float drive);
 
+    // Retunes one of this instance's tone filters (see tuneToneFilter)
+    void setToneFilter(PreampType type, float tone) noexcept;
+
     // ======================================
     // State
     // ======================================
+    // All fixed-size DSP state (filter coefficients and history, effect
+    // state) lives inline in this object; only delay lines live in the
+    // effect arena. Members are grouped so that everything the active preamp
+    // touches per sample - its filters, saturation state and its five
+    // effects - sits in adjacent cache lines, with each preamp's group
+    // starting on a fresh line.
+
+    // Shared, touched every sample whatever the preamp type
     PreampType currentPreampType = PreampType::Cathode;
+    PreampType pendingPreampType = PreampType::Cathode;  // Set by setPreampType()
+    double sampleRate = 44100.0;
 
     // Parameters
     juce::SmoothedValue<float> driveGain;
     juce::SmoothedValue<float> toneValue;
     juce::SmoothedValue<float> outputGain;
 
+    // Per-sample parameter values for the current slice, one channel each.
+    // Both chains read them during a preamp crossfade.
+    enum ParameterRamp { driveRamp, toneRamp, outputGainRamp, numParameterRamps };
+    juce::AudioBuffer<float> parameterRamps;
+
+    // Shared tanh table for the Cathode and Steel Plate shapers, picked up
+    // each slice
+    const DspTables::Table* tanhTable = nullptr;
+    const DspTables::Table* cutoffTable = nullptr;  // Tone filter prewarp at sampleRate
+
     // ======================================
-    // Cathode-specific filters (warm, vintage)
+    // Cathode (warm, vintage)
     // ======================================
-    juce::dsp::IIR::Filter<float> cathToneL;
-    juce::dsp::IIR::Filter<float> cathToneR;
-    juce::dsp::IIR::Filter<float> cathWarmthL;  // Low shelf boost
-    juce::dsp::IIR::Filter<float> cathWarmthR;
-    juce::dsp::IIR::Filter<float> cathRolloffL; // High rolloff
-    juce::dsp::IIR::Filter<float> cathRolloffR;
+    alignas(64) StereoSvf cathTone;  // Swept by the tone control
+    BiquadCascade<3> cathEq;  // Warmth low shelf, high rolloff, DC blocker
 
     // Cathode state for tube-like behavior
     float cathLastSampleL = 0.0f;
@@ -112,40 +263,6 @@ private:
     float cathBiasL = 0.0f;  // Simulates tube bias drift
     float cathBiasR = 0.0f;
 
-    // ======================================
-    // Filament-specific filters (cold, precise)
-    // ======================================
-    juce::dsp::IIR::Filter<float> filToneL;
-    juce::dsp::IIR::Filter<float> filToneR;
-    juce::dsp::IIR::Filter<float> filPresenceL;  // High shelf for shimmer
-    juce::dsp::IIR::Filter<float> filPresenceR;
-
-    // ======================================
-    // Steel Plate-specific filters (aggressive)
-    // ======================================
-    juce::dsp::IIR::Filter<float> steelToneL;
-    juce::dsp::IIR::Filter<float> steelToneR;
-    juce::dsp::IIR::Filter<float> steelScoopL;    // Mid scoop
-    juce::dsp::IIR::Filter<float> steelScoopR;
-    juce::dsp::IIR::Filter<float> steelPresenceL; // Harsh presence
-    juce::dsp::IIR::Filter<float> steelPresenceR;
-
-    // Steel Plate state for gritty behavior
-    float steelRectifyL = 0.0f;
-    float steelRectifyR = 0.0f;
-
-    // ======================================
-    // Shared
-    // ======================================
-    juce::dsp::IIR::Filter<float> dcBlockerL;
-    juce::dsp::IIR::Filter<float> dcBlockerR;
-
-    double sampleRate = 44100.0;
-
-    // ======================================
-    // Effect Instances
-    // ======================================
-
     // Cathode Effects (Warm, Vintage, Tube)
     EmberDSP cathEmber;    // Distortion
     VelvetDSP cathVelvet;  // Filter
@@ -153,6 +270,12 @@ private:
     EchoDSP cathEcho;      // Delay
     HazeDSP cathHaze;      // Reverb
 
+    // ======================================
+    // Filament (cold, precise)
+    // ======================================
+    alignas(64) StereoSvf filTone;  // Swept by the tone control
+    BiquadCascade<2> filEq;  // Presence high shelf, DC blocker
+
     // Filament Effects (Cold, Digital, Precise)
     FractureDSP filFracture;  // Distortion
     PrismDSP filPrism;        // Filter
@@ -160,12 +283,63 @@ private:
     CascadeDSP filCascade;    // Delay
     GlistenDSP filGlisten;    // Reverb
 
+    // ======================================
+    // Steel Plate (aggressive)
+    // ======================================
+    alignas(64) StereoSvf steelTone;  // Swept by the tone control
+    BiquadCascade<3> steelEq;  // Mid scoop, harsh presence, DC blocker
+
+    // Steel Plate state for gritty behavior
+    float steelRectifyL = 0.0f;
+    float steelRectifyR = 0.0f;
+
     // Steel Plate Effects (Aggressive, Industrial, Raw)
     ScorchDSP steelScorch;  // Distortion
     SnarlDSP steelSnarl;    // Filter
     ShredDSP steelShred;    // Modulation
     GrindDSP steelGrind;    // Delay
     RustDSP steelRust;      // Reverb
+
+    // ======================================
+    // Cold: setup and bookkeeping
+    // ======================================
+
+    // Preamp crossfade: the outgoing chain renders into crossfadeBuffer
+    PreampType fadingPreampType = PreampType::Cathode;
+    int crossfadeLengthSamples = 0;
+    int crossfadeSamplesRemaining = 0;
+    juce::AudioBuffer<float> crossfadeBuffer;
+
+    // Lookup tables shared with every other instance in the process
+    juce::SharedResourcePointer<DspTables> sharedTables;
+
+    // Effects per preamp type, in processing order
+    static constexpr int numEffectsPerPreamp = 5;
+    std::array<std::array<EffectBase*, numEffectsPerPreamp>, 3> chainEffects {};
+
+    // Delay memory for the chains that have been used since construction.
+    // A chain keeps its memory across re-prepares, so the arena only grows
+    // the first time a preamp is selected.
+    DspArena effectArena;
+    juce::CriticalSection effectArenaLock;  // prepare vs. message-thread allocation
+    std::atomic<bool> effectMemoryRequested { false };
+
+    // Bit per preamp type: chains whose effects all have memory (written
+    // under effectArenaLock), and chains the audio thread is waiting for
+    std::atomic<int> chainsWithMemory { 0 };
+    std::atomic<int> requestedChains { 0 };
+
+    static constexpr int chainBit(PreampType type) noexcept { return 1 << static_cast<int>(type); }
+    bool hasChainMemory(PreampType type) const noexcept
+    {
+        return (chainsWithMemory.load(std::memory_order_acquire) & chainBit(type)) != 0;
+    }
+
+    // Carves a chain's memory out of the arena. Call with effectArenaLock held.
+    bool allocateChainMemory(PreampType type);
+
+    StageProfiler stageProfiler;
+    static_assert(numStages <= StageProfiler::maxStages);
 };
 
 // Template implementation
@@ -175,7 +349,6 @@ void PreampDSP::process(const ProcessContext& context)
     auto& inputBlock = context.getInputBlock();
     auto& outputBlock = context.getOutputBlock();
 
-    const auto numChannels = outputBlock.getNumChannels();
     const auto numSamples = outputBlock.getNumSamples();
 
     if (context.isBypassed)
@@ -184,12 +357,123 @@ void PreampDSP::process(const ProcessContext& context)
         return;
     }
 
+    jassert(outputBlock.getNumChannels() <= 2);
+
+    // The parameter ramps and the crossfade buffer hold one prepared block,
+    // so anything larger is processed in slices
+    const auto maxSliceSize = static_cast<size_t>(parameterRamps.getNumSamples());
+
+    if (maxSliceSize == 0)
+    {
+        jassertfalse;  // prepare() hasn't been called
+        return;
+    }
+
+    for (size_t start = 0; start < numSamples; start += maxSliceSize)
+    {
+        const auto sliceSize = juce::jmin(maxSliceSize, numSamples - start);
+        processSlice(inputBlock.getSubBlock(start, sliceSize), outputBlock.getSubBlock(start, sliceSize));
+    }
+}
+
+template <typename InputBlock, typename OutputBlock>
+void PreampDSP::processSlice(const InputBlock& inputBlock, const OutputBlock& outputBlock)
+{
+    const auto numChannels = outputBlock.getNumChannels();
+    const auto numSamples = outputBlock.getNumSamples();
+
+    bool waitingForMemory = false;
+
+    // A new preamp type was selected: start fading over to it once its
+    // effects have their memory. Until then the old preamp carries on.
+    if (pendingPreampType != currentPreampType && crossfadeSamplesRemaining == 0)
+    {
+        if (hasChainMemory(pendingPreampType))
+        {
+            beginPreampCrossfade();
+        }
+        else
+        {
+            requestedChains.fetch_or(chainBit(pendingPreampType), std::memory_order_relaxed);
+            waitingForMemory = true;
+        }
+    }
+
+    fillParameterRamps(static_cast<int>(numSamples));
+    tanhTable = sharedTables->get(DspTableType::Tanh);
+    cutoffTable = sharedTables->get(DspTableType::CutoffGain, sampleRate);
+
+    const bool crossfading = crossfadeSamplesRemaining > 0;
+
+    // ======================================
+    // Outgoing chain (crossfade only)
+    // ======================================
+    // Runs first, since input and output may be the same buffer. It renders
+    // into the crossfade buffer, following the same parameter ramps.
+    if (crossfading)
+    {
+        float* fadeChannels[2] = { crossfadeBuffer.getWritePointer(0), crossfadeBuffer.getWritePointer(1) };
+
+        {
+            ScopedStageTimer timer(stageProfiler, getStageIndex(fadingPreampType, 0));
+            processPreamp(fadingPreampType, inputBlock, fadeChannels, numChannels, numSamples);
+        }
+
+        waitingForMemory |= processEffects(fadingPreampType,
+                                           fadeChannels[0],
+                                           (numChannels > 1) ? fadeChannels[1] : fadeChannels[0],
+                                           static_cast<int>(numSamples));
+    }
+
+    // ======================================
+    // Active chain
+    // ======================================
+    float* outputChannels[2] = { outputBlock.getChannelPointer(0),
+                                 (numChannels > 1) ? outputBlock.getChannelPointer(1) : nullptr };
+
+    {
+        ScopedStageTimer timer(stageProfiler, getStageIndex(currentPreampType, 0));
+        processPreamp(currentPreampType, inputBlock, outputChannels, numChannels, numSamples);
+    }
+
+    waitingForMemory |= processEffects(currentPreampType,
+                                       outputChannels[0],
+                                       (numChannels > 1) ? outputChannels[1] : outputChannels[0],
+                                       static_cast<int>(numSamples));
+
+    if (crossfading)
+        applyPreampCrossfade(outputChannels, numChannels, static_cast<int>(numSamples));
+
+    if (waitingForMemory)
+        effectMemoryRequested.store(true, std::memory_order_release);
+}
+
+template <typename InputBlock>
+void PreampDSP::processPreamp(PreampType type, const InputBlock& inputBlock,
+                              float* const* outputChannels, size_t numChannels, size_t numSamples)
+{
+    const auto& kernels = getDspKernels();
+    const float* drives = parameterRamps.getReadPointer(driveRamp);
+    const float* tones = parameterRamps.getReadPointer(toneRamp);
+
+    // Filament's shaper has no state, so it runs over the whole block in the
+    // vectorised kernel up front. Cathode and Steel Plate carry state from
+    // one sample to the next and stay in the per-sample loop.
+    if (type == PreampType::Filament)
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            kernels.filamentShape(inputBlock.getChannelPointer(channel), drives,
+                                  outputChannels[channel], static_cast<int>(numSamples));
+
     // Process preamp per-sample with type-specific saturation
     for (size_t sample = 0; sample < numSamples; ++sample)
     {
-        float drive = driveGain.getNextValue();
-        float tone = toneValue.getNextValue();
-        float outGain = outputGain.getNextValue();
+        float drive = drives[sample];
+        float tone = tones[sample];
+
+        // The tone filters are state-variable, so retuning them every sample
+        // while the knob moves is cheap and click-free
+        if (sample == 0 || tone != tones[sample - 1])
+            setToneFilter(type, tone);
 
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
@@ -200,136 +484,81 @@ void PreampDSP::process(const ProcessContext& context)
             float processed = 0.0f;
 
             // Apply preamp-specific saturation
-            switch (currentPreampType)
+            switch (type)
             {
                 case PreampType::Cathode:
                     processed = processCathodeSample(input, drive);
                     break;
                 case PreampType::Filament:
-                    processed = processFilamentSample(input, drive);
+                    processed = outputChannels[channel][sample];  // Shaped above
                     break;
                 case PreampType::SteelPlate:
                     processed = processSteelPlateSample(input, drive);
                     break;
             }
 
-            // Apply preamp-specific tone shaping
-            switch (currentPreampType)
+            // Apply preamp-specific tone control
+            switch (type)
             {
-                case PreampType::Cathode:
-                {
-                    // Update Cathode tone filters
-                    float cutoff = 600.0f + (tone * 3000.0f);  // 600Hz to 3.6kHz - warmer range
-                    auto toneCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-                        sampleRate, cutoff, 0.6f, 0.6f + tone * 0.8f);
-
-                    if (channel == 0)
-                    {
-                        *cathToneL.coefficients = *toneCoeffs;
-                        processed = cathToneL.processSample(processed);
-                        processed = cathWarmthL.processSample(processed);  // Low boost
-                        processed = cathRolloffL.processSample(processed); // High rolloff
-                        processed = dcBlockerL.processSample(processed);
-                    }
-                    else
-                    {
-                        *cathToneR.coefficients = *toneCoeffs;
-                        processed = cathToneR.processSample(processed);
-                        processed = cathWarmthR.processSample(processed);
-                        processed = cathRolloffR.processSample(processed);
-                        processed = dcBlockerR.processSample(processed);
-                    }
-                    break;
-                }
-                case PreampType::Filament:
-                {
-                    // Update Filament tone filters - precise, flat with shimmer
-                    float cutoff = 1000.0f + (tone * 6000.0f);  // 1kHz to 7kHz - brighter range
-                    auto toneCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-                        sampleRate, cutoff, 0.707f, 0.7f + tone * 0.6f);
-
-                    if (channel == 0)
-                    {
-                        *filToneL.coefficients = *toneCoeffs;
-                        processed = filToneL.processSample(processed);
-                        processed = filPresenceL.processSample(processed);  // Crystalline highs
-                        processed = dcBlockerL.processSample(processed);
-                    }
-                    else
-                    {
-                        *filToneR.coefficients = *toneCoeffs;
-                        processed = filToneR.processSample(processed);
-                        processed = filPresenceR.processSample(processed);
-                        processed = dcBlockerR.processSample(processed);
-                    }
-                    break;
-                }
-                case PreampType::SteelPlate:
-                {
-                    // Update Steel Plate tone filters - aggressive, scooped
-                    float cutoff = 800.0f + (tone * 4000.0f);
-                    auto toneCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-                        sampleRate, cutoff, 1.5f, 0.5f + tone);
-
-                    if (channel == 0)
-                    {
-                        *steelToneL.coefficients = *toneCoeffs;
-                        processed = steelToneL.processSample(processed);
-                        processed = steelScoopL.processSample(processed);    // Mid scoop
-                        processed = steelPresenceL.processSample(processed); // Harsh presence
-                        processed = dcBlockerL.processSample(processed);
-                    }
-                    else
-                    {
-                        *steelToneR.coefficients = *toneCoeffs;
-                        processed = steelToneR.processSample(processed);
-                        processed = steelScoopR.processSample(processed);
-                        processed = steelPresenceR.processSample(processed);
-                        processed = dcBlockerR.processSample(processed);
-                    }
-                    break;
-                }
+                case PreampType::Cathode:    processed = cathTone.processSample(channel, processed);  break;
+                case PreampType::Filament:   processed = filTone.processSample(channel, processed);   break;
+                case PreampType::SteelPlate: processed = steelTone.processSample(channel, processed); break;
             }
 
-            // Output gain
-            float output = processed * outGain;
-            outputBlock.setSample(ch, smp, output);
+            outputChannels[channel][sample] = processed;
         }
     }
 
-    // ======================================
-    // Effects Chain Processing - ONLY active preamp's effects
-    // ======================================
+    // Fixed voicing EQ and DC blocker, a block at a time
+    float* rightChannel = (numChannels > 1) ? outputChannels[1] : nullptr;
 
-    auto numSamplesInt = static_cast<int>(numSamples);
-    float* leftChannel = outputBlock.getChannelPointer(0);
-    float* rightChannel = (numChannels > 1) ? outputBlock.getChannelPointer(1) : leftChannel;
+    switch (type)
+    {
+        case PreampType::Cathode:    cathEq.process(outputChannels[0], rightChannel, static_cast<int>(numSamples));  break;
+        case PreampType::Filament:   filEq.process(outputChannels[0], rightChannel, static_cast<int>(numSamples));   break;
+        case PreampType::SteelPlate: steelEq.process(outputChannels[0], rightChannel, static_cast<int>(numSamples)); break;
+    }
 
-    switch (currentPreampType)
+    // Output gain
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        kernels.multiply(outputChannels[channel], parameterRamps.getReadPointer(outputGainRamp),
+                         static_cast<int>(numSamples));
+}
+
+// ======================================
+// Effects Chain Processing - one preamp's effects
+// ======================================
+inline bool PreampDSP::processEffects(PreampType type, float* leftChannel, float* rightChannel, int numSamples)
+{
+    // Chains are composed at compile time (see EffectChain.h). Adjacent
+    // effects without delay memory are fused into a single loop.
+    switch (type)
     {
         case PreampType::Cathode:
             // Order: Distortion -> Filter -> Modulation -> Delay -> Reverb
-            cathEmber.process(leftChannel, rightChannel, numSamplesInt);
-            cathVelvet.process(leftChannel, rightChannel, numSamplesInt);
-            cathDrift.process(leftChannel, rightChannel, numSamplesInt);
-            cathEcho.process(leftChannel, rightChannel, numSamplesInt);
-            cathHaze.process(leftChannel, rightChannel, numSamplesInt);
-            break;
+            return processTimedEffectChain(stageProfiler, getStageIndex(type, 1),
+                                           leftChannel, rightChannel, numSamples,
+                                           fuse(cathEmber, cathVelvet),
+                                           cathDrift,
+                                           cathEcho,
+                                           cathHaze);
 
         case PreampType::Filament:
-            filFracture.process(leftChannel, rightChannel, numSamplesInt);
-            filPrism.process(leftChannel, rightChannel, numSamplesInt);
-            filPhase.process(leftChannel, rightChannel, numSamplesInt);
-            filCascade.process(leftChannel, rightChannel, numSamplesInt);
-            filGlisten.process(leftChannel, rightChannel, numSamplesInt);
-            break;
+            return processTimedEffectChain(stageProfiler, getStageIndex(type, 1),
+                                           leftChannel, rightChannel, numSamples,
+                                           filFracture,
+                                           filPrism,
+                                           filPhase,
+                                           filCascade,
+                                           filGlisten);
 
         case PreampType::SteelPlate:
-            steelScorch.process(leftChannel, rightChannel, numSamplesInt);
-            steelSnarl.process(leftChannel, rightChannel, numSamplesInt);
-            steelShred.process(leftChannel, rightChannel, numSamplesInt);
-            steelGrind.process(leftChannel, rightChannel, numSamplesInt);
-            steelRust.process(leftChannel, rightChannel, numSamplesInt);
-            break;
+            return processTimedEffectChain(stageProfiler, getStageIndex(type, 1),
+                                           leftChannel, rightChannel, numSamples,
+                                           fuse(steelScorch, steelSnarl, steelShred),
+                                           steelGrind,
+                                           steelRust);
     }
+
+    return false;
 }
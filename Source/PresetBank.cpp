@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Factory preset bank
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+#include "PresetData.h"
+
+namespace
+{
+    int getPreampIndex(const juce::String& preamp)
+    {
+        if (preamp == "filament") return 1;
+        if (preamp == "steelplate") return 2;
+        return 0;
+    }
+}
+
+PresetBank::PresetBank()
+{
+    int dataSize = 0;
+    const char* data = PresetData::getNamedResource("FactoryPresets_json", dataSize);
+
+    jassert(data != nullptr);
+    if (data == nullptr)
+        return;
+
+    auto parsed = juce::JSON::parse(juce::String::fromUTF8(data, dataSize));
+    auto* entries = parsed.getProperty("presets", juce::var()).getArray();
+
+    jassert(entries != nullptr);
+    if (entries == nullptr)
+        return;
+
+    for (const auto& entry : *entries)
+    {
+        const auto& values = entry["values"];
+
+        FactoryPreset preset;
+        preset.id = entry["id"].toString();
+        preset.name = entry["name"].toString();
+        preset.description = entry["description"].toString();
+        preset.preampType = getPreampIndex(entry["preamp"].toString());
+        preset.drive = static_cast<float>(values["drive"]);
+        preset.tone = static_cast<float>(values["tone"]);
+        preset.output = static_cast<float>(values["output"]);
+
+        if (auto* effects = values["effects"].getArray())
+            for (int i = 0; i < juce::jmin(effects->size(), ParameterSnapshot::numEffectsPerPreamp); ++i)
+                preset.effects[static_cast<size_t>(i)] = static_cast<float>((*effects)[i]);
+
+        presets.push_back(std::move(preset));
+    }
+}
+
+const FactoryPreset* PresetBank::getPreset(int index) const noexcept
+{
+    return juce::isPositiveAndBelow(index, size()) ? &presets[static_cast<size_t>(index)] : nullptr;
+}
+
+int PresetBank::indexOf(const juce::String& id) const noexcept
+{
+    for (int i = 0; i < size(); ++i)
+        if (presets[static_cast<size_t>(i)].id == id)
+            return i;
+
+    return -1;
+}
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Factory preset bank
+
+    Loaded from Resources/Presets/FactoryPresets.json, compiled into the
+    binary. The web UI builds its preset menus from the same file.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "ParameterSnapshot.h"
+
+//==============================================================================
+struct FactoryPreset
+{
+    juce::String id;
+    juce::String name;
+    juce::String description;
+
+    int preampType = 0;  // Choice index, as in ParameterSnapshot
+    float drive = 0.25f;
+    float tone = 0.5f;
+    float output = 0.5f;
+    ParameterSnapshot::EffectMixes effects {};  // The preamp's own effects
+
+    // The preset laid over the current values: it sets its preamp and that
+    // preamp's effects, and leaves the other preamps' effects alone
+    ParameterSnapshot applyTo(ParameterSnapshot snapshot) const noexcept
+    {
+        snapshot.preampType = preampType;
+        snapshot.drive = drive;
+        snapshot.tone = tone;
+        snapshot.output = output;
+        snapshot.getEffects(preampType) = effects;
+        return snapshot;
+    }
+};
+
+//==============================================================================
+class PresetBank
+{
+public:
+    PresetBank();
+
+    int size() const noexcept { return static_cast<int>(presets.size()); }
+
+    // Null when out of range
+    const FactoryPreset* getPreset(int index) const noexcept;
+
+    // -1 if no preset has this id
+    int indexOf(const juce::String& id) const noexcept;
+
+private:
+    std::vector<FactoryPreset> presets;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Trace recorder
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+#include <chrono>
+#include <map>
+
+namespace
+{
+    // Automatic dumps after a deadline miss, at most this often
+    constexpr double minAutomaticDumpIntervalMs = 10000.0;
+
+    std::atomic<uint32_t> threadsSeen { 0 };
+}
+
+//==============================================================================
+TraceRecorder::TraceRecorder()
+    : juce::Thread("Dre-Dimura trace")
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    setEnabled(false);
+}
+
+void TraceRecorder::setEnabled(bool shouldBeEnabled)
+{
+    if (shouldBeEnabled == isEnabled())
+        return;
+
+    if (shouldBeEnabled)
+    {
+        if (slots == nullptr)
+            slots = std::make_unique<std::array<Slot, ringSize>>();
+
+        enabled.store(true, std::memory_order_release);
+        startThread(juce::Thread::Priority::background);
+    }
+    else
+    {
+        enabled.store(false, std::memory_order_release);
+        stopThread(2000);
+    }
+}
+
+//==============================================================================
+uint64_t TraceRecorder::nowNs() noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint32_t TraceRecorder::getThreadId() noexcept
+{
+    // Small, stable numbers are easier to read in the trace than OS ids
+    thread_local const uint32_t id = ++threadsSeen;
+    return id;
+}
+
+void TraceRecorder::addComplete(const char* category, const char* name, uint64_t startNs, uint64_t endNs,
+                                int64_t value) noexcept
+{
+    add('X', category, name, startNs, endNs - startNs, value);
+}
+
+void TraceRecorder::addInstant(const char* category, const char* name, int64_t value) noexcept
+{
+    add('i', category, name, nowNs(), 0, value);
+}
+
+void TraceRecorder::add(char phase, const char* category, const char* name, uint64_t startNs, uint64_t durationNs,
+                        int64_t value) noexcept
+{
+    if (! isEnabled())
+        return;
+
+    const auto index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = (*slots)[static_cast<size_t>(index % ringSize)];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(durationNs, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.threadId.store(getThreadId(), std::memory_order_relaxed);
+    slot.phase.store(phase, std::memory_order_relaxed);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+void TraceRecorder::requestDump(bool fromDeadlineMiss) noexcept
+{
+    if (! isEnabled())
+        return;
+
+    if (fromDeadlineMiss)
+    {
+        int expected = 0;
+        dumpRequested.compare_exchange_strong(expected, 2, std::memory_order_release);
+    }
+    else
+    {
+        dumpRequested.store(1, std::memory_order_release);
+    }
+}
+
+juce::File TraceRecorder::getTraceDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("Dre-Dimura")
+        .getChildFile("Traces");
+}
+
+//==============================================================================
+void TraceRecorder::run()
+{
+    // Polled rather than signalled, so requesting a dump never touches a
+    // lock on the audio thread
+    while (! threadShouldExit())
+    {
+        const int request = dumpRequested.exchange(0, std::memory_order_acquire);
+
+        if (request != 0)
+            writeTrace(request == 2);
+
+        wait(100);
+    }
+}
+
+void TraceRecorder::writeTrace(bool fromDeadlineMiss)
+{
+    const auto nowMs = juce::Time::getMillisecondCounterHiRes();
+
+    if (fromDeadlineMiss)
+    {
+        if (lastAutomaticDumpMs > 0.0 && nowMs - lastAutomaticDumpMs < minAutomaticDumpIntervalMs)
+            return;
+
+        lastAutomaticDumpMs = nowMs;
+    }
+
+    // Copy out everything still in the ring, skipping slots caught mid-write
+    const auto end = writeIndex.load(std::memory_order_acquire);
+    const auto begin = end > static_cast<uint64_t>(ringSize) ? end - ringSize : 0;
+
+    std::vector<Event> events;
+    events.reserve(static_cast<size_t>(end - begin));
+
+    for (auto index = begin; index < end; ++index)
+    {
+        const auto& slot = (*slots)[static_cast<size_t>(index % ringSize)];
+
+        const auto before = slot.sequence.load(std::memory_order_acquire);
+        if (before != 2 * index + 2)
+            continue;
+
+        Event event {
+            slot.category.load(std::memory_order_relaxed),
+            slot.name.load(std::memory_order_relaxed),
+            slot.startNs.load(std::memory_order_relaxed),
+            slot.durationNs.load(std::memory_order_relaxed),
+            slot.value.load(std::memory_order_relaxed),
+            slot.threadId.load(std::memory_order_relaxed),
+            slot.phase.load(std::memory_order_relaxed)
+        };
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before)
+            continue;
+
+        events.push_back(event);
+    }
+
+    if (events.empty())
+        return;
+
+    // Chrome trace format: microsecond timestamps, from the first event
+    const auto origin = std::min_element(events.begin(), events.end(),
+                                         [](const Event& a, const Event& b) { return a.startNs < b.startNs; })->startNs;
+
+    juce::MemoryOutputStream json;
+    json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    std::map<uint32_t, const char*> threadNames;
+
+    for (const auto& event : events)
+    {
+        threadNames.emplace(event.threadId, event.category);
+
+        json << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+             << "\",\"ph\":\"" << juce::String::charToString(event.phase)
+             << "\",\"ts\":" << juce::String(static_cast<double>(event.startNs - origin) / 1000.0, 3);
+
+        if (event.phase == 'X')
+            json << ",\"dur\":" << juce::String(static_cast<double>(event.durationNs) / 1000.0, 3);
+        else
+            json << ",\"s\":\"t\"";
+
+        json << ",\"pid\":1,\"tid\":" << static_cast<int>(event.threadId)
+             << ",\"args\":{\"value\":" << juce::String(event.value) << "}},\n";
+    }
+
+    // Name each thread after the category of its first event
+    for (const auto& [threadId, name] : threadNames)
+        json << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << static_cast<int>(threadId)
+             << ",\"args\":{\"name\":\"" << name << " (" << static_cast<int>(threadId) << ")\"}},\n";
+
+    json << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Dre-Dimura\"}}\n]}\n";
+
+    const auto directory = getTraceDirectory();
+    directory.createDirectory();
+
+    const auto file = directory.getChildFile(juce::Time::getCurrentTime().formatted("trace-%Y%m%d-%H%M%S")
+                                             + (fromDeadlineMiss ? "-deadline" : "") + ".json")
+                          .getNonexistentSibling();
+
+    if (file.replaceWithText(json.toString()))
+        juce::Logger::writeToLog("Dre-Dimura: wrote trace of " + juce::String(static_cast<int>(events.size()))
+                                 + " events to " + file.getFullPathName());
+}
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Trace recorder
+    Vintage preamp coloration utility
+
+    A flight recorder for dropouts on machines we can't attach a profiler
+    to. The audio thread, the message thread, WebView event handlers and
+    activation calls write fixed-size events into one ring buffer without
+    locking; a background thread writes the ring out as a Chrome trace
+    (chrome://tracing, Perfetto) on request, or by itself after a missed
+    deadline.
+
+    Compiled in, off by default, and shared by every instance in the process
+    (hold it through juce::SharedResourcePointer). Disabled, recording an
+    event is one relaxed load.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+class TraceRecorder : private juce::Thread
+{
+public:
+    static constexpr int ringSize = 1 << 15;  // Events kept; the oldest are overwritten
+
+    // Category names, shown as thread names in the trace
+    static constexpr const char* audio = "audio";
+    static constexpr const char* message = "message";
+    static constexpr const char* webView = "webview";
+    static constexpr const char* activation = "activation";
+
+    TraceRecorder();
+    ~TraceRecorder() override;
+
+    // Allocates the ring the first time it is enabled (message thread)
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_acquire); }
+
+    //==============================================================================
+    // Any thread, lock-free. category and name must be string literals.
+    static uint64_t nowNs() noexcept;
+
+    void addComplete(const char* category, const char* name, uint64_t startNs, uint64_t endNs,
+                     int64_t value = 0) noexcept;
+    void addInstant(const char* category, const char* name, int64_t value = 0) noexcept;
+
+    // Asks the background thread to write the trace. Safe from the audio
+    // thread; automatic dumps (fromDeadlineMiss) are rate limited.
+    void requestDump(bool fromDeadlineMiss = false) noexcept;
+
+    // Where traces are written
+    static juce::File getTraceDirectory();
+
+    //==============================================================================
+    /** Records its scope as one complete event, if tracing is enabled */
+    class Scope
+    {
+    public:
+        Scope(TraceRecorder& recorderToUse, const char* scopeCategory, const char* scopeName, int64_t scopeValue = 0) noexcept
+            : recorder(recorderToUse.isEnabled() ? &recorderToUse : nullptr),
+              category(scopeCategory), name(scopeName), value(scopeValue),
+              start(recorder != nullptr ? nowNs() : 0)
+        {
+        }
+
+        ~Scope()
+        {
+            if (recorder != nullptr)
+                recorder->addComplete(category, name, start, nowNs(), value);
+        }
+
+    private:
+        TraceRecorder* recorder;
+        const char* category;
+        const char* name;
+        int64_t value;
+        uint64_t start;
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+private:
+    //==============================================================================
+    // One event. Each field is atomic so a reader can copy a slot while it
+    // is being overwritten; sequence tells it whether the copy is whole.
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence { 0 };  // 2 * index + 1 while writing, 2 * index + 2 when done
+        std::atomic<const char*> category { nullptr };
+        std::atomic<const char*> name { nullptr };
+        std::atomic<uint64_t> startNs { 0 };
+        std::atomic<uint64_t> durationNs { 0 };
+        std::atomic<int64_t> value { 0 };
+        std::atomic<uint32_t> threadId { 0 };
+        std::atomic<char> phase { 'X' };
+    };
+
+    struct Event
+    {
+        const char* category;
+        const char* name;
+        uint64_t startNs, durationNs;
+        int64_t value;
+        uint32_t threadId;
+        char phase;
+    };
+
+    void add(char phase, const char* category, const char* name, uint64_t startNs, uint64_t durationNs,
+             int64_t value) noexcept;
+
+    void run() override;
+    void writeTrace(bool fromDeadlineMiss);
+
+    static uint32_t getThreadId() noexcept;
+
+    std::unique_ptr<std::array<Slot, ringSize>> slots;
+    std::atomic<bool> enabled { false };
+    std::atomic<uint64_t> writeIndex { 0 };
+
+    std::atomic<int> dumpRequested { 0 };  // 1 on request, 2 after a deadline miss
+    double lastAutomaticDumpMs = 0.0;      // Background thread
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceRecorder)
+};
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Embedded WebUI resources
+  ==============================================================================
+*/
+
+#include "WebUIResources.h"
+#include "WebUIData.h"
+#include <list>
+
+namespace
+{
+    const char* getMimeType(const juce::String& fileName)
+    {
+        if (fileName.endsWith(".html")) return "text/html";
+        if (fileName.endsWith(".css")) return "text/css";
+        if (fileName.endsWith(".js")) return "application/javascript";
+        if (fileName.endsWith(".json")) return "application/json";
+        if (fileName.endsWith(".png")) return "image/png";
+        if (fileName.endsWith(".jpg") || fileName.endsWith(".jpeg")) return "image/jpeg";
+        if (fileName.endsWith(".svg")) return "image/svg+xml";
+        if (fileName.endsWith(".woff")) return "font/woff";
+        if (fileName.endsWith(".woff2")) return "font/woff2";
+        return "application/octet-stream";
+    }
+
+    class WebUITable
+    {
+    public:
+        struct Entry
+        {
+            juce::String path;  // Relative to Resources/WebUI, e.g. "assets/index.js"
+            const void* data;
+            size_t size;
+            const char* mimeType;
+        };
+
+        WebUITable()
+        {
+            for (int i = 0; i < WebUIData::namedResourceListSize; ++i)
+            {
+                const auto* name = WebUIData::namedResourceList[i];
+                const juce::String fileName (WebUIData::getNamedResourceOriginalFilename(name));
+
+                // Staged as the relative path with "%" and "/" escaped (CMakeLists.txt)
+                const auto path = fileName.replace("%2F", "/").replace("%25", "%");
+
+                int size = 0;
+                const auto* data = WebUIData::getNamedResource(name, size);
+
+                if (data == nullptr)
+                    continue;
+
+                if (path.endsWith(".gz"))
+                {
+                    // Precompressed at build time: inflate once, keep for good
+                    const auto inflatedPath = path.dropLastCharacters(3);
+
+                    juce::MemoryInputStream compressed (data, static_cast<size_t>(size), false);
+                    juce::GZIPDecompressorInputStream decompressor (&compressed, false,
+                                                                    juce::GZIPDecompressorInputStream::gzipFormat);
+
+                    auto& block = decompressed.emplace_back();
+                    decompressor.readIntoMemoryBlock(block);
+
+                    entries.push_back({ inflatedPath, block.getData(), block.getSize(), getMimeType(inflatedPath) });
+                }
+                else
+                {
+                    // Served straight out of the binary's read-only data
+                    entries.push_back({ path, data, static_cast<size_t>(size), getMimeType(path) });
+                }
+            }
+        }
+
+        const Entry* find(const juce::String& path) const
+        {
+            for (const auto& entry : entries)
+                if (entry.path == path)
+                    return &entry;
+
+            return nullptr;
+        }
+
+    private:
+        std::vector<Entry> entries;
+        std::list<juce::MemoryBlock> decompressed;  // Stable addresses for entries
+    };
+
+    const WebUITable& getWebUITable()
+    {
+        static const WebUITable table;
+        return table;
+    }
+}
+
+std::optional<juce::WebBrowserComponent::Resource> getWebUIResource(const juce::String& url)
+{
+    auto path = url.upToFirstOccurrenceOf("?", false, false)
+                   .upToFirstOccurrenceOf("#", false, false);
+
+    // The whole path below the root, so files of the same name in different
+    // directories stay apart
+    path = path.trimCharactersAtStart("/");
+    if (path.isEmpty())
+        path = "index.html";
+
+    const auto* entry = getWebUITable().find(path);
+    if (entry == nullptr)
+        return std::nullopt;
+
+    // Resource owns its bytes, so this one copy (from memory) is unavoidable
+    const auto* bytes = static_cast<const std::byte*>(entry->data);
+    return juce::WebBrowserComponent::Resource { std::vector<std::byte> (bytes, bytes + entry->size),
+                                                 entry->mimeType };
+}
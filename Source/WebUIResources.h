@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Embedded WebUI resources
+
+    The built web UI (Resources/WebUI) is compiled into the binary as JUCE
+    binary data, optionally gzip-compressed (DRE_DIMURA_COMPRESS_WEBUI).
+    On first use it is indexed, and decompressed if needed, into a table
+    that lives for the rest of the process, so opening an editor touches
+    neither the disk nor the decompressor.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_gui_extra/juce_gui_extra.h>
+#include <optional>
+
+// Resolves a resource provider URL ("/", "/index.html", "/assets/index.js")
+// by its full path below Resources/WebUI.
+std::optional<juce::WebBrowserComponent::Resource> getWebUIResource(const juce::String& url);
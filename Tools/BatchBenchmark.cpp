@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Batch benchmark
+
+    Times N independent mono streams through one preset, each in its own
+    PreampDSP, against the same streams through one PreampBatch (one stream
+    per SIMD lane in the preamp stage), and checks how far the two outputs
+    differ. The tone knob moves every second, so the smoothing and filter
+    retuning paths are timed too.
+
+    Usage: DreDimura_BatchBenchmark [sampleRate] [blockSize] [seconds] [effectMix]
+
+    effectMix (default 0) turns up every effect of the preamp under test;
+    the effect chains run a stream at a time either way.
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include "PreampBatch.h"
+
+namespace
+{
+    struct Settings
+    {
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        double seconds = 10.0;
+        float effectMix = 0.0f;
+        int repeats = 3;
+    };
+
+    ParameterSnapshot makeParameters(PreampType type, float tone, const Settings& settings)
+    {
+        ParameterSnapshot parameters;
+        parameters.preampType = static_cast<int>(type);
+        parameters.drive = 0.7f;
+        parameters.tone = tone;
+        parameters.output = 0.6f;
+        parameters.getEffects(parameters.preampType).fill(settings.effectMix);
+        return parameters;
+    }
+
+    // A different signal in every stream: noise over a sine at its own pitch
+    void fillStreams(juce::AudioBuffer<float>& buffer, double sampleRate)
+    {
+        juce::Random random(1234);
+
+        for (int stream = 0; stream < buffer.getNumChannels(); ++stream)
+        {
+            const double frequency = 55.0 * (1.0 + stream * 0.37);
+            float* samples = buffer.getWritePointer(stream);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                samples[i] = 0.4f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * frequency * i / sampleRate))
+                           + (random.nextFloat() * 2.0f - 1.0f) * 0.1f;
+        }
+    }
+
+    // Runs every stream through processBlock a block at a time, returns
+    // seconds taken. setParameters is called at the start and every second.
+    template <typename SetParameters, typename ProcessBlock>
+    double timeRun(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output, const Settings& settings,
+                   SetParameters&& setParameters, ProcessBlock&& processBlock)
+    {
+        output.makeCopyOf(input, true);
+
+        std::vector<float*> channels(static_cast<size_t>(output.getNumChannels()));
+        const int samplesPerSecond = static_cast<int>(settings.sampleRate);
+        int nextChange = samplesPerSecond;
+
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int pos = 0; pos < output.getNumSamples(); pos += settings.blockSize)
+        {
+            const int n = juce::jmin(settings.blockSize, output.getNumSamples() - pos);
+
+            if (pos >= nextChange)
+            {
+                setParameters((pos / samplesPerSecond) % 2 == 0 ? 0.5f : 0.8f);
+                nextChange += samplesPerSecond;
+            }
+
+            for (size_t stream = 0; stream < channels.size(); ++stream)
+                channels[stream] = output.getWritePointer(static_cast<int>(stream)) + pos;
+
+            processBlock(channels.data(), n);
+        }
+
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    }
+
+    void benchmarkBatch(const char* name, PreampType type, int numStreams, const Settings& settings)
+    {
+        juce::AudioBuffer<float> input(numStreams, static_cast<int>(settings.sampleRate * settings.seconds));
+        fillStreams(input, settings.sampleRate);
+
+        juce::AudioBuffer<float> scalarOut, batchOut;
+        double bestScalar = 1.0e9, bestBatch = 1.0e9;
+
+        for (int run = 0; run < settings.repeats; ++run)
+        {
+            // Fresh state for every run so both paths start identically
+            std::vector<std::unique_ptr<PreampDSP>> preamps;
+            const juce::dsp::ProcessSpec spec { settings.sampleRate, static_cast<juce::uint32>(settings.blockSize), 1 };
+
+            for (int stream = 0; stream < numStreams; ++stream)
+            {
+                preamps.push_back(std::make_unique<PreampDSP>());
+                preamps.back()->setParameters(makeParameters(type, 0.5f, settings));
+                preamps.back()->prepare(spec);
+            }
+
+            auto batch = std::make_unique<PreampBatch>();
+            batch->setParameters(makeParameters(type, 0.5f, settings));
+            batch->prepare(settings.sampleRate, settings.blockSize, numStreams);
+
+            // Today's path: one PreampDSP per stream
+            bestScalar = juce::jmin(bestScalar, timeRun(input, scalarOut, settings,
+                [&](float tone)
+                {
+                    for (auto& preamp : preamps)
+                        preamp->setParameters(makeParameters(type, tone, settings));
+                },
+                [&](float* const* channels, int n)
+                {
+                    for (size_t stream = 0; stream < preamps.size(); ++stream)
+                    {
+                        juce::dsp::AudioBlock<float> block(channels + stream, 1, static_cast<size_t>(n));
+                        juce::dsp::ProcessContextReplacing<float> context(block);
+                        preamps[stream]->process(context);
+                    }
+                }));
+
+            bestBatch = juce::jmin(bestBatch, timeRun(input, batchOut, settings,
+                [&](float tone) { batch->setParameters(makeParameters(type, tone, settings)); },
+                [&](float* const* channels, int n) { batch->process(channels, channels, n); }));
+        }
+
+        float maxDiff = 0.0f;
+        for (int stream = 0; stream < numStreams; ++stream)
+            for (int i = 0; i < input.getNumSamples(); ++i)
+                maxDiff = juce::jmax(maxDiff, std::abs(scalarOut.getSample(stream, i) - batchOut.getSample(stream, i)));
+
+        const auto streamSamples = static_cast<double>(input.getNumSamples()) * numStreams;
+        std::printf("%-12s %2d streams   scalar %7.2f ns/sample   batch %7.2f ns/sample   speedup %5.2fx   max diff %g\n",
+                    name, numStreams,
+                    bestScalar * 1.0e9 / streamSamples,
+                    bestBatch * 1.0e9 / streamSamples,
+                    bestScalar / bestBatch,
+                    static_cast<double>(maxDiff));
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    if (argc > 1) settings.sampleRate = std::atof(argv[1]);
+    if (argc > 2) settings.blockSize = std::atoi(argv[2]);
+    if (argc > 3) settings.seconds = std::atof(argv[3]);
+    if (argc > 4) settings.effectMix = static_cast<float>(std::atof(argv[4]));
+
+    if (settings.sampleRate <= 0.0 || settings.blockSize <= 0 || settings.seconds <= 0.0
+        || settings.effectMix < 0.0f || settings.effectMix > 1.0f)
+    {
+        std::printf("Usage: DreDimura_BatchBenchmark [sampleRate] [blockSize] [seconds] [effectMix]\n");
+        return 1;
+    }
+
+    juce::ScopedNoDenormals noDenormals;
+
+    std::printf("Mono streams, drive 70%%, effects at %.0f%%: %.0f Hz, %d-sample blocks, %.1f s of audio, best of %d\n",
+                settings.effectMix * 100.0f, settings.sampleRate, settings.blockSize, settings.seconds, settings.repeats);
+    std::printf("PreampBatch runs %d lanes (%s kernels for Filament's shaper)\n",
+                PreampBatch::getLaneWidth(), getDspKernels().name);
+
+    const std::pair<const char*, PreampType> types[] = { { "Cathode", PreampType::Cathode },
+                                                         { "Filament", PreampType::Filament },
+                                                         { "Steel Plate", PreampType::SteelPlate } };
+
+    for (const auto& [name, type] : types)
+        for (int numStreams : { 1, 4, 8, 16 })
+            benchmarkBatch(name, type, numStreams, settings);
+
+    return 0;
+}
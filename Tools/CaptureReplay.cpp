@@ -0,0 +1,345 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Capture replay
+
+    Runs a capture made by the plugin (DreDimuraProcessor::startCapture)
+    back through PreampDSP offline: the same input, the same parameter
+    changes at the same samples, the same block sizes and preparation.
+    Each block's output is checked bit for bit against the hash recorded
+    live, and the slowest blocks are listed so the failing sequence can be
+    profiled on its own. Replay on the machine the capture came from: the
+    SIMD kernels picked at runtime differ between CPUs.
+
+    Usage: DreDimura_CaptureReplay <capture.ddcap> [repeats] [output.wav]
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "PreampDSP.h"
+#include "CaptureRecorder.h"
+
+namespace
+{
+    struct Block
+    {
+        CaptureFormat::BlockHeader header {};
+        juce::AudioBuffer<float> input;
+        std::vector<CaptureFormat::Segment> segments;
+    };
+
+    struct Record
+    {
+        CaptureFormat::RecordType type = CaptureFormat::blockRecord;
+        CaptureFormat::FormatRecord format {};
+        uint32_t droppedBlocks = 0;
+        Block block;
+    };
+
+    //==========================================================================
+    bool readCapture(const juce::File& file, std::vector<Record>& records)
+    {
+        juce::FileInputStream stream(file);
+        if (! stream.openedOk())
+        {
+            std::printf("Can't open %s\n", file.getFullPathName().toRawUTF8());
+            return false;
+        }
+
+        CaptureFormat::FileHeader header {};
+        if (stream.read(&header, sizeof(header)) != static_cast<int>(sizeof(header))
+            || ! std::equal(std::begin(header.magic), std::end(header.magic), std::begin(CaptureFormat::magic)))
+        {
+            std::printf("%s is not a Dre-Dimura capture\n", file.getFullPathName().toRawUTF8());
+            return false;
+        }
+
+        if (header.version != CaptureFormat::version || header.snapshotBytes != sizeof(ParameterSnapshot))
+        {
+            std::printf("Capture is from a different build (version %u, %u-byte snapshots)\n",
+                        header.version, header.snapshotBytes);
+            return false;
+        }
+
+        juce::MemoryBlock payload;
+
+        for (;;)
+        {
+            CaptureFormat::RecordHeader recordHeader {};
+            if (stream.read(&recordHeader, sizeof(recordHeader)) != static_cast<int>(sizeof(recordHeader)))
+                break;
+
+            payload.setSize(recordHeader.size);
+            if (stream.read(payload.getData(), static_cast<int>(recordHeader.size)) != static_cast<int>(recordHeader.size))
+            {
+                std::printf("Capture ends part way through a record; replaying what came before it\n");
+                break;
+            }
+
+            const auto* bytes = static_cast<const char*>(payload.getData());
+            Record record;
+            record.type = static_cast<CaptureFormat::RecordType>(recordHeader.type);
+
+            switch (record.type)
+            {
+                case CaptureFormat::formatRecord:
+                    std::memcpy(&record.format, bytes, sizeof(record.format));
+                    break;
+
+                case CaptureFormat::gapRecord:
+                    std::memcpy(&record.droppedBlocks, bytes, sizeof(record.droppedBlocks));
+                    break;
+
+                case CaptureFormat::blockRecord:
+                {
+                    auto& block = record.block;
+                    std::memcpy(&block.header, bytes, sizeof(block.header));
+                    bytes += sizeof(block.header);
+
+                    const auto numChannels = static_cast<int>(block.header.numChannels);
+                    const auto numSamples = static_cast<int>(block.header.numSamples);
+                    block.input.setSize(numChannels, numSamples);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        std::memcpy(block.input.getWritePointer(channel), bytes, sizeof(float) * static_cast<size_t>(numSamples));
+                        bytes += sizeof(float) * static_cast<size_t>(numSamples);
+                    }
+
+                    block.segments.resize(block.header.numSegments);
+                    std::memcpy(block.segments.data(), bytes, sizeof(CaptureFormat::Segment) * block.segments.size());
+                    break;
+                }
+
+                default:
+                    continue;  // From a newer build: skip it
+            }
+
+            records.push_back(std::move(record));
+        }
+
+        return true;
+    }
+
+    //==========================================================================
+    struct BlockResult
+    {
+        size_t blockIndex;
+        double seconds;  // Best over all repeats
+        double budgetSeconds;
+    };
+
+    struct Replay
+    {
+        std::vector<BlockResult> timings;
+        size_t mismatches = 0;
+        size_t firstMismatch = 0;
+        uint32_t droppedBlocks = 0;
+    };
+
+    // One pass over the whole capture, mirroring DreDimuraProcessor::processBlock.
+    // Only the first pass checks and writes the output.
+    void replay(const std::vector<Record>& records, Replay& result, bool firstPass, juce::AudioBuffer<float>* output)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        auto preampDSP = std::make_unique<PreampDSP>();
+        double sampleRate = 0.0;
+        uint32_t effectAllocations = 0;
+        size_t blockIndex = 0;
+        juce::AudioBuffer<float> buffer;
+
+        // Preamp chains the live DSP had given memory by then
+        auto allocateChains = [&preampDSP](uint32_t chains)
+        {
+            for (auto type : { PreampType::Cathode, PreampType::Filament, PreampType::SteelPlate })
+                if ((chains & (1u << static_cast<int>(type))) != 0)
+                    preampDSP->allocateEffectMemory(type);
+        };
+
+        for (const auto& record : records)
+        {
+            if (record.type == CaptureFormat::formatRecord)
+            {
+                const auto& format = record.format;
+                sampleRate = format.sampleRate;
+                effectAllocations = format.effectAllocations;
+
+                // prepare() builds any lookup table this rate needs before it
+                // returns, so the first replayed block reads the same tables as
+                // the live one did, however new this process is
+                const juce::dsp::ProcessSpec spec { format.sampleRate, format.maximumBlockSize, format.numChannels };
+                preampDSP->setParameters(format.parameters);
+                preampDSP->prepare(spec);
+                allocateChains(format.chainsWithMemory);
+                continue;
+            }
+
+            if (record.type == CaptureFormat::gapRecord)
+            {
+                if (firstPass)
+                    result.droppedBlocks += record.droppedBlocks;
+                continue;
+            }
+
+            const auto& block = record.block;
+            const int numSamples = static_cast<int>(block.header.numSamples);
+            buffer.makeCopyOf(block.input, true);
+
+            // Memory the message thread had allocated by the time this block
+            // ran. Live, that cost never fell on the block, so it stays
+            // outside the timing.
+            if (block.header.effectAllocations != effectAllocations)
+            {
+                preampDSP->allocateRequestedEffectMemory();
+                effectAllocations = block.header.effectAllocations;
+            }
+
+            allocateChains(block.header.chainsWithMemory);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+
+            switch (block.header.mode)
+            {
+                case CaptureFormat::bypassed:
+                    preampDSP->reset();
+                    break;
+
+                case CaptureFormat::asleep:
+                    buffer.clear();
+                    break;
+
+                default:
+                {
+                    juce::dsp::AudioBlock<float> audioBlock(buffer);
+
+                    for (size_t i = 0; i < block.segments.size(); ++i)
+                    {
+                        const auto segmentStart = static_cast<int>(block.segments[i].startSample);
+                        const auto segmentEnd = i + 1 < block.segments.size()
+                                              ? static_cast<int>(block.segments[i + 1].startSample)
+                                              : numSamples;
+
+                        preampDSP->setParameters(block.segments[i].parameters);
+
+                        if (segmentEnd > segmentStart)
+                        {
+                            auto subBlock = audioBlock.getSubBlock(static_cast<size_t>(segmentStart),
+                                                                   static_cast<size_t>(segmentEnd - segmentStart));
+                            juce::dsp::ProcessContextReplacing<float> context(subBlock);
+                            preampDSP->process(context);
+                        }
+                    }
+                    break;
+                }
+            }
+
+            const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            if (blockIndex == result.timings.size())
+                result.timings.push_back({ blockIndex, seconds, numSamples / sampleRate });
+            else
+                result.timings[blockIndex].seconds = juce::jmin(result.timings[blockIndex].seconds, seconds);
+
+            if (firstPass && CaptureRecorder::hashAudio(buffer) != block.header.outputHash)
+            {
+                if (result.mismatches++ == 0)
+                    result.firstMismatch = blockIndex;
+            }
+
+            if (firstPass && output != nullptr)
+            {
+                const int position = output->getNumSamples();
+                output->setSize(buffer.getNumChannels(), position + numSamples, true);
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    output->copyFrom(channel, position, buffer, channel, 0, numSamples);
+            }
+
+            ++blockIndex;
+        }
+    }
+
+    void writeWav(const juce::File& file, const juce::AudioBuffer<float>& audio, double sampleRate)
+    {
+        file.deleteFile();
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wav.createWriterFor(new juce::FileOutputStream(file), sampleRate,
+                                static_cast<unsigned int>(audio.getNumChannels()), 32, {}, 0));
+
+        if (writer != nullptr && writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples()))
+            std::printf("Wrote output to %s\n", file.getFullPathName().toRawUTF8());
+        else
+            std::printf("Couldn't write %s\n", file.getFullPathName().toRawUTF8());
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("Usage: DreDimura_CaptureReplay <capture.ddcap> [repeats] [output.wav]\n");
+        return 1;
+    }
+
+    const auto captureFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[1]);
+    const int repeats = argc > 2 ? juce::jmax(1, std::atoi(argv[2])) : 1;
+    const auto outputFile = argc > 3 ? juce::File::getCurrentWorkingDirectory().getChildFile(argv[3]) : juce::File();
+
+    std::vector<Record> records;
+    if (! readCapture(captureFile, records))
+        return 1;
+
+    const auto firstFormat = std::find_if(records.begin(), records.end(),
+                                          [](const Record& r) { return r.type == CaptureFormat::formatRecord; });
+    if (firstFormat == records.end())
+    {
+        std::printf("Capture has no format record\n");
+        return 1;
+    }
+
+    Replay result;
+    juce::AudioBuffer<float> output;
+
+    for (int run = 0; run < repeats; ++run)
+        replay(records, result, run == 0, run == 0 && outputFile != juce::File() ? &output : nullptr);
+
+    double totalSeconds = 0.0, totalBudget = 0.0;
+    for (const auto& timing : result.timings)
+    {
+        totalSeconds += timing.seconds;
+        totalBudget += timing.budgetSeconds;
+    }
+
+    std::printf("%zu blocks, %.2f s of audio at %.0f Hz, best of %d: %.1f%% of real time\n",
+                result.timings.size(), totalBudget, firstFormat->format.sampleRate, repeats,
+                totalBudget > 0.0 ? 100.0 * totalSeconds / totalBudget : 0.0);
+
+    if (result.droppedBlocks > 0)
+        std::printf("%u blocks were dropped while capturing; output after the first gap may differ\n",
+                    result.droppedBlocks);
+
+    if (result.mismatches == 0)
+        std::printf("Output matches the capture bit for bit\n");
+    else
+        std::printf("Output differs in %zu blocks, first at block %zu\n", result.mismatches, result.firstMismatch);
+
+    // Slowest blocks, against their real-time budget
+    auto slowest = result.timings;
+    std::sort(slowest.begin(), slowest.end(),
+              [](const BlockResult& a, const BlockResult& b) { return a.seconds / a.budgetSeconds > b.seconds / b.budgetSeconds; });
+
+    std::printf("Slowest blocks:\n");
+    for (size_t i = 0; i < juce::jmin(slowest.size(), static_cast<size_t>(10)); ++i)
+        std::printf("  block %8zu  %9.1f us  %6.1f%% of budget\n", slowest[i].blockIndex,
+                    slowest[i].seconds * 1.0e6, 100.0 * slowest[i].seconds / slowest[i].budgetSeconds);
+
+    if (outputFile != juce::File())
+        writeWav(outputFile, output, firstFormat->format.sampleRate);
+
+    return result.mismatches == 0 ? 0 : 2;
+}
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Effect chain benchmark
+
+    Times each preamp's effect chain run through EffectBase::process
+    (virtual dispatch, one pass per effect) against the compile-time
+    composed chain PreampDSP uses (static dispatch, fused stages), and
+    checks that both produce identical output.
+
+    Usage: DreDimura_ChainBenchmark [sampleRate] [blockSize] [seconds]
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include "Effects/EffectChain.h"
+
+namespace
+{
+    struct Settings
+    {
+        double sampleRate = 48000.0;
+        int blockSize = 256;
+        double seconds = 20.0;
+        int repeats = 5;
+    };
+
+    //==========================================================================
+    // One set of effects per chain, mirroring PreampDSP's composition
+
+    struct CathodeChain
+    {
+        EmberDSP ember; VelvetDSP velvet; DriftDSP drift; EchoDSP echo; HazeDSP haze;
+
+        std::vector<EffectBase*> effects() { return { &ember, &velvet, &drift, &echo, &haze }; }
+
+        void processComposed(float* l, float* r, int n)
+        {
+            processEffectChain(l, r, n, fuse(ember, velvet), drift, echo, haze);
+        }
+    };
+
+    struct FilamentChain
+    {
+        FractureDSP fracture; PrismDSP prism; PhaseDSP phase; CascadeDSP cascade; GlistenDSP glisten;
+
+        std::vector<EffectBase*> effects() { return { &fracture, &prism, &phase, &cascade, &glisten }; }
+
+        void processComposed(float* l, float* r, int n)
+        {
+            processEffectChain(l, r, n, fracture, prism, phase, cascade, glisten);
+        }
+    };
+
+    struct SteelPlateChain
+    {
+        ScorchDSP scorch; SnarlDSP snarl; ShredDSP shred; GrindDSP grind; RustDSP rust;
+
+        std::vector<EffectBase*> effects() { return { &scorch, &snarl, &shred, &grind, &rust }; }
+
+        void processComposed(float* l, float* r, int n)
+        {
+            processEffectChain(l, r, n, fuse(scorch, snarl, shred), grind, rust);
+        }
+    };
+
+    //==========================================================================
+    template <typename Chain>
+    void prepareChain(Chain& chain, DspArena& arena, const Settings& settings)
+    {
+        juce::dsp::ProcessSpec spec { settings.sampleRate, static_cast<juce::uint32>(settings.blockSize), 2 };
+
+        size_t bytes = 0;
+        for (auto* effect : chain.effects())
+        {
+            effect->setMix(0.5f);
+            effect->prepare(spec);
+            bytes += effect->getReservedDelayMemorySize();
+        }
+
+        arena.prepare(bytes);
+
+        for (auto* effect : chain.effects())
+        {
+            effect->allocateDelayMemory(arena);
+            effect->reset();
+        }
+    }
+
+    void fillNoise(juce::AudioBuffer<float>& buffer)
+    {
+        juce::Random random(1234);
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.3f);
+    }
+
+    // Runs the whole input through processBlock, returns seconds taken
+    template <typename ProcessBlock>
+    double timeRun(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+                   int blockSize, ProcessBlock&& processBlock)
+    {
+        output.makeCopyOf(input, true);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int pos = 0; pos < output.getNumSamples(); pos += blockSize)
+        {
+            const int n = juce::jmin(blockSize, output.getNumSamples() - pos);
+            processBlock(output.getWritePointer(0) + pos, output.getWritePointer(1) + pos, n);
+        }
+
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    }
+
+    template <typename Chain>
+    void benchmarkChain(const char* name, const juce::AudioBuffer<float>& input, const Settings& settings)
+    {
+        juce::AudioBuffer<float> virtualOut, composedOut;
+        double bestVirtual = 1.0e9, bestComposed = 1.0e9;
+
+        for (int run = 0; run < settings.repeats; ++run)
+        {
+            // Fresh state for every run so both paths start identically
+            auto virtualChain = std::make_unique<Chain>();
+            auto composedChain = std::make_unique<Chain>();
+            DspArena virtualArena, composedArena;
+            prepareChain(*virtualChain, virtualArena, settings);
+            prepareChain(*composedChain, composedArena, settings);
+
+            // Today's path: one virtual call and one pass per effect
+            auto effects = virtualChain->effects();
+            bestVirtual = juce::jmin(bestVirtual, timeRun(input, virtualOut, settings.blockSize,
+                [&](float* l, float* r, int n)
+                {
+                    for (auto* effect : effects)
+                        effect->process(l, r, n);
+                }));
+
+            bestComposed = juce::jmin(bestComposed, timeRun(input, composedOut, settings.blockSize,
+                [&](float* l, float* r, int n) { composedChain->processComposed(l, r, n); }));
+        }
+
+        float maxDiff = 0.0f;
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < input.getNumSamples(); ++i)
+                maxDiff = juce::jmax(maxDiff, std::abs(virtualOut.getSample(ch, i) - composedOut.getSample(ch, i)));
+
+        const auto numSamples = static_cast<double>(input.getNumSamples());
+        std::printf("%-12s virtual %8.2f ns/sample   composed %8.2f ns/sample   speedup %5.2fx   max diff %g\n",
+                    name,
+                    bestVirtual * 1.0e9 / numSamples,
+                    bestComposed * 1.0e9 / numSamples,
+                    bestVirtual / bestComposed,
+                    static_cast<double>(maxDiff));
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    Settings settings;
+    if (argc > 1) settings.sampleRate = std::atof(argv[1]);
+    if (argc > 2) settings.blockSize = std::atoi(argv[2]);
+    if (argc > 3) settings.seconds = std::atof(argv[3]);
+
+    if (settings.sampleRate <= 0.0 || settings.blockSize <= 0 || settings.seconds <= 0.0)
+    {
+        std::printf("Usage: DreDimura_ChainBenchmark [sampleRate] [blockSize] [seconds]\n");
+        return 1;
+    }
+
+    juce::ScopedNoDenormals noDenormals;
+
+    juce::AudioBuffer<float> input(2, static_cast<int>(settings.sampleRate * settings.seconds));
+    fillNoise(input);
+
+    std::printf("Effect chains, all mixes at 50%%: %.0f Hz, %d-sample blocks, %.1f s of audio, best of %d\n",
+                settings.sampleRate, settings.blockSize, settings.seconds, settings.repeats);
+
+    benchmarkChain<CathodeChain>("Cathode", input, settings);
+    benchmarkChain<FilamentChain>("Filament", input, settings);
+    benchmarkChain<SteelPlateChain>("Steel Plate", input, settings);
+
+    return 0;
+}
@@ -0,0 +1,404 @@
+/*
+  ==============================================================================
+    Dre-Dimura - Offline batch render
+
+    Prints a set of WAV/AIFF files (reamped DI takes, typically) through one
+    fixed preset or saved plugin state. Each file gets its own PreampDSP on
+    a thread pool as wide as the machine, so a batch runs on every core. It
+    is processed in large blocks, with its reading buffered ahead and its
+    writing buffered behind on an I/O thread of its own. Output keeps the
+    input's name, format, sample rate, bit depth and metadata (so BWF
+    timestamps still line up); effect tails are rendered past the end
+    unless --no-tail is given.
+
+    Usage: DreDimura_Render (--preset <id|index> | --state <file>) --out <dir>
+                            [--threads N] [--block N] [--no-tail] <files or dirs...>
+           DreDimura_Render --list-presets
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_dsp/juce_dsp.h>
+#include "ParameterIDs.h"
+#include "PreampDSP.h"
+#include "PresetBank.h"
+
+namespace
+{
+    // Per file: how far reading runs ahead of, and writing behind, the DSP
+    constexpr int ioBufferSamples = 1 << 18;
+
+    struct Settings
+    {
+        ParameterSnapshot parameters;
+        juce::File outputDirectory;
+        int numThreads = juce::SystemStats::getNumCpus();
+        int blockSize = 8192;
+        bool renderTail = true;
+        juce::Array<juce::File> inputs;
+    };
+
+    struct FileResult
+    {
+        bool rendered = false;
+        juce::String error;
+        double audioSeconds = 0.0;
+        double renderSeconds = 0.0;
+    };
+
+    void printUsage()
+    {
+        std::printf("Usage: DreDimura_Render (--preset <id|index> | --state <file>) --out <dir>\n"
+                    "                        [--threads N] [--block N] [--no-tail] <files or dirs...>\n"
+                    "       DreDimura_Render --list-presets\n");
+    }
+
+    //==========================================================================
+    void listPresets()
+    {
+        const PresetBank bank;
+
+        for (int i = 0; i < bank.size(); ++i)
+        {
+            const auto* preset = bank.getPreset(i);
+            std::printf("%3d  %-24s %s\n", i, preset->id.toRawUTF8(), preset->name.toRawUTF8());
+        }
+    }
+
+    bool loadPreset(const juce::String& idOrIndex, ParameterSnapshot& parameters)
+    {
+        const PresetBank bank;
+
+        int index = bank.indexOf(idOrIndex);
+        if (index < 0 && idOrIndex.containsOnly("0123456789"))
+            index = idOrIndex.getIntValue();
+
+        const auto* preset = bank.getPreset(index);
+        if (preset == nullptr)
+        {
+            std::printf("No preset \"%s\" (see --list-presets)\n", idOrIndex.toRawUTF8());
+            return false;
+        }
+
+        parameters = preset->applyTo(ParameterSnapshot());
+        std::printf("Preset %d: %s\n", index, preset->name.toRawUTF8());
+        return true;
+    }
+
+    // A state chunk as DreDimuraProcessor::getStateInformation() writes it
+    // (XML behind AudioProcessor::copyXmlToBinary's magic number and
+    // length), or the XML on its own
+    bool loadState(const juce::File& file, ParameterSnapshot& parameters)
+    {
+        juce::MemoryBlock data;
+        if (! file.loadFileAsData(data))
+        {
+            std::printf("Can't read %s\n", file.getFullPathName().toRawUTF8());
+            return false;
+        }
+
+        constexpr uint32_t binaryXmlMagic = 0x21324356;
+        const auto* bytes = static_cast<const char*>(data.getData());
+        juce::String text;
+
+        if (data.getSize() > 8 && juce::ByteOrder::littleEndianInt(bytes) == binaryXmlMagic)
+        {
+            const auto length = juce::jmin(static_cast<size_t>(juce::ByteOrder::littleEndianInt(bytes + 4)), data.getSize() - 8);
+            text = juce::String::fromUTF8(bytes + 8, static_cast<int>(length));
+        }
+        else
+        {
+            text = data.toString();
+        }
+
+        const auto xml = juce::parseXML(text);
+        if (xml == nullptr || ! xml->hasTagName("Parameters"))
+        {
+            std::printf("%s is not a Dre-Dimura state\n", file.getFullPathName().toRawUTF8());
+            return false;
+        }
+
+        // Parameters missing from older states keep their defaults
+        auto read = [&xml](const char* parameterID, float& value)
+        {
+            if (auto* param = xml->getChildByAttribute("id", parameterID))
+                value = static_cast<float>(param->getDoubleAttribute("value", value));
+        };
+
+        float preampType = static_cast<float>(parameters.preampType);
+        read(ParameterIDs::preampType, preampType);
+        parameters.preampType = juce::jlimit(0, 2, juce::roundToInt(preampType));
+
+        read(ParameterIDs::drive, parameters.drive);
+        read(ParameterIDs::tone, parameters.tone);
+        read(ParameterIDs::output, parameters.output);
+
+        for (int preamp = 0; preamp < 3; ++preamp)
+        {
+            auto& effects = parameters.getEffects(preamp);
+            for (size_t i = 0; i < effects.size(); ++i)
+                read(ParameterIDs::effects[preamp][i], effects[i]);
+        }
+
+        float bypass = 0.0f;
+        read(ParameterIDs::bypass, bypass);
+        if (bypass > 0.5f)
+            std::printf("Note: the state is bypassed; rendering with the preamp on anyway\n");
+
+        return true;
+    }
+
+    //==========================================================================
+    FileResult renderFile(const juce::File& input, const Settings& settings, juce::AudioFormatManager& formats)
+    {
+        FileResult result;
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        const auto output = settings.outputDirectory.getChildFile(input.getFileName());
+        if (output == input)
+        {
+            result.error = "output would overwrite the input";
+            return result;
+        }
+
+        std::unique_ptr<juce::AudioFormatReader> source(formats.createReaderFor(input));
+        if (source == nullptr)
+        {
+            result.error = "not a readable audio file";
+            return result;
+        }
+
+        const auto numChannels = static_cast<int>(source->numChannels);
+        if (numChannels < 1 || numChannels > 2)
+        {
+            result.error = "only mono and stereo files are supported";
+            return result;
+        }
+
+        const double sampleRate = source->sampleRate;
+        const auto length = source->lengthInSamples;
+        const auto bitsPerSample = static_cast<int>(source->bitsPerSample);
+        const auto metadata = source->metadataValues;
+
+        auto* format = formats.findFormatForFileExtension(output.getFileExtension());
+        output.deleteFile();
+        auto stream = std::make_unique<juce::FileOutputStream>(output);
+
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        if (format != nullptr && stream->openedOk())
+            writer.reset(format->createWriterFor(stream.get(), sampleRate, static_cast<unsigned int>(numChannels),
+                                                 bitsPerSample, metadata, 0));
+
+        if (writer == nullptr)
+        {
+            result.error = "can't write " + output.getFullPathName();
+            return result;
+        }
+
+        stream.release();  // Owned by the writer now
+
+        {
+            // Destroyed in reverse: the reader and writer (which flushes)
+            // leave the I/O thread before it stops
+            juce::TimeSliceThread ioThread("Dre-Dimura render I/O");
+            ioThread.startThread(juce::Thread::Priority::normal);
+
+            juce::BufferingAudioReader reader(source.release(), ioThread, ioBufferSamples);
+            reader.setReadTimeout(-1);  // Wait for read-ahead rather than return silence
+
+            juce::AudioFormatWriter::ThreadedWriter threadedWriter(writer.release(), ioThread, ioBufferSamples);
+
+            auto preampDSP = std::make_unique<PreampDSP>();
+            preampDSP->setParameters(settings.parameters);
+            preampDSP->prepare({ sampleRate, static_cast<juce::uint32>(settings.blockSize), static_cast<juce::uint32>(numChannels) });
+
+            const auto tailSamples = settings.renderTail
+                                   ? static_cast<juce::int64>(std::ceil(preampDSP->getTailLengthSeconds() * sampleRate))
+                                   : 0;
+            const auto totalSamples = length + tailSamples;
+
+            juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+
+            for (juce::int64 position = 0; position < totalSamples; position += settings.blockSize)
+            {
+                const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(settings.blockSize), totalSamples - position));
+                buffer.setSize(numChannels, numSamples, false, false, true);
+
+                // Past the end of the file (the tail) reads as silence
+                if (position < length)
+                    reader.read(&buffer, 0, numSamples, position, true, true);
+                else
+                    buffer.clear();
+
+                // Nothing is real-time here: effect memory is allocated in line
+                if (preampDSP->hasPendingEffectMemoryRequests())
+                    preampDSP->allocateRequestedEffectMemory();
+
+                juce::dsp::AudioBlock<float> block(buffer);
+                juce::dsp::ProcessContextReplacing<float> context(block);
+                preampDSP->process(context);
+
+                while (! threadedWriter.write(buffer.getArrayOfReadPointers(), numSamples))
+                    juce::Thread::sleep(1);  // Write-behind full: let the disk catch up
+            }
+
+            result.audioSeconds = static_cast<double>(totalSamples) / sampleRate;
+        }
+
+        result.renderSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        result.rendered = true;
+        return result;
+    }
+
+    //==========================================================================
+    bool parseArguments(const juce::StringArray& args, Settings& settings)
+    {
+        bool haveParameters = false;
+
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto& arg = args[i];
+            const bool hasValue = i + 1 < args.size();
+
+            if (arg == "--preset" && hasValue)
+            {
+                if (! loadPreset(args[++i], settings.parameters))
+                    return false;
+
+                haveParameters = true;
+            }
+            else if (arg == "--state" && hasValue)
+            {
+                if (! loadState(juce::File::getCurrentWorkingDirectory().getChildFile(args[++i]), settings.parameters))
+                    return false;
+
+                haveParameters = true;
+            }
+            else if (arg == "--out" && hasValue)
+            {
+                settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(args[++i]);
+            }
+            else if (arg == "--threads" && hasValue)
+            {
+                settings.numThreads = juce::jmax(1, args[++i].getIntValue());
+            }
+            else if (arg == "--block" && hasValue)
+            {
+                settings.blockSize = juce::jlimit(64, 1 << 16, args[++i].getIntValue());
+            }
+            else if (arg == "--no-tail")
+            {
+                settings.renderTail = false;
+            }
+            else if (arg.startsWith("--"))
+            {
+                std::printf("Unknown option %s\n", arg.toRawUTF8());
+                return false;
+            }
+            else
+            {
+                const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(arg);
+
+                if (file.isDirectory())
+                    settings.inputs.addArray(file.findChildFiles(juce::File::findFiles, false, "*.wav;*.aif;*.aiff"));
+                else
+                    settings.inputs.add(file);
+            }
+        }
+
+        if (! haveParameters || settings.outputDirectory == juce::File() || settings.inputs.isEmpty())
+        {
+            printUsage();
+            return false;
+        }
+
+        if (! settings.outputDirectory.createDirectory())
+        {
+            std::printf("Can't create %s\n", settings.outputDirectory.getFullPathName().toRawUTF8());
+            return false;
+        }
+
+        return true;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::String::fromUTF8(argv[i]));
+
+    if (args.contains("--list-presets"))
+    {
+        listPresets();
+        return 0;
+    }
+
+    Settings settings;
+    if (! parseArguments(args, settings))
+        return 1;
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    const int numFiles = settings.inputs.size();
+    const int numThreads = juce::jmin(settings.numThreads, numFiles);
+    std::vector<FileResult> results(static_cast<size_t>(numFiles));
+
+    std::printf("Rendering %d files on %d threads, %d-sample blocks\n", numFiles, numThreads, settings.blockSize);
+
+    juce::CriticalSection printLock;
+    int numFinished = 0;
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    {
+        juce::ThreadPool pool(juce::ThreadPoolOptions{}
+                                  .withThreadName("Dre-Dimura render")
+                                  .withNumberOfThreads(numThreads));
+
+        for (int i = 0; i < numFiles; ++i)
+        {
+            pool.addJob([&, i]
+            {
+                // Each worker gets its own denormal mode
+                juce::ScopedNoDenormals workerNoDenormals;
+
+                const auto& input = settings.inputs.getReference(i);
+                auto& result = results[static_cast<size_t>(i)];
+                result = renderFile(input, settings, formats);
+
+                const juce::ScopedLock sl(printLock);
+                ++numFinished;
+
+                if (result.rendered)
+                    std::printf("[%4d/%d] %-40s %8.1f s  %7.1fx realtime\n", numFinished, numFiles,
+                                input.getFileName().toRawUTF8(), result.audioSeconds,
+                                result.audioSeconds / result.renderSeconds);
+                else
+                    std::printf("[%4d/%d] %-40s failed: %s\n", numFinished, numFiles,
+                                input.getFileName().toRawUTF8(), result.error.toRawUTF8());
+            });
+        }
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+    }
+
+    const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+    int numRendered = 0;
+    double audioSeconds = 0.0;
+    for (const auto& result : results)
+    {
+        numRendered += result.rendered ? 1 : 0;
+        audioSeconds += result.audioSeconds;
+    }
+
+    std::printf("Rendered %d of %d files: %.1f s of audio in %.2f s, %.1fx realtime (%.1fx per thread)\n",
+                numRendered, numFiles, audioSeconds, elapsed,
+                audioSeconds / elapsed, audioSeconds / elapsed / numThreads);
+
+    return numRendered == numFiles ? 0 : 1;
+}
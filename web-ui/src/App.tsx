@@ -1,10 +1,13 @@
 import React, { useState, useCallback, useEffect } from 'react';
 import { useSliderParam, useToggleParam, useComboParam, applyBatchUpdates } from './hooks/useJuceParam';
-import { useAudioLevels } from './hooks/useAudioLevels';
+import { useMeterLevel, MeterSource } from './hooks/useAudioLevels';
 import { useActivation } from './hooks/useActivation';
+import { isInJuceWebView } from './lib/juce-bridge';
 import { Knob } from './components/Knob';
 import { EffectModule } from './components/EffectModule';
 import { PresetSelector } from './components/PresetSelector';
+import { AnalysisView } from './components/AnalysisView';
+import { PerformancePanel } from './components/PerformancePanel';
 import { PreampTooltipTrigger } from './components/PreampTooltip';
 import { ActivationScreen } from './components/ActivationScreen';
 import { HearthglowBackground } from './components/artwork/HearthglowBackground';
@@ -60,7 +63,8 @@ const PREAMPS = [
 ];
 
 // Cathode VU Meter - Classic analog style
-function CathodeVUMeter({ level }: { level: number }) {
+function CathodeVUMeter() {
+  const level = useMeterLevel('output');
   const percentage = Math.min(100, level * 100);
   return (
     <div className="vu-meter cathode-meter">
@@ -79,7 +83,9 @@ function CathodeVUMeter({ level }: { level: number }) {
 }
 
 // Filament Oscilloscope Display - Animated waveform visualizer
-function FilamentOscilloscope({ level, color }: { level: number; color: number }) {
+function FilamentOscilloscope({ color }: { color: number }) {
+  const level = useMeterLevel('output');
+
   // Generate waveform path based on level and color (affects wave shape)
   const generateWavePath = () => {
     const points: string[] = [];
@@ -224,7 +230,8 @@ function FilamentOscilloscope({ level, color }: { level: number; color: number }
 }
 
 // Filament Mini Meter - Compact vertical indicator
-function FilamentMiniMeter({ level, label }: { level: number; label: string }) {
+function FilamentMiniMeter({ source, label }: { source: MeterSource; label: string }) {
+  const level = useMeterLevel(source);
   return (
     <div className="mini-meter">
       <div className="mini-meter-track">
@@ -300,7 +307,8 @@ function FilamentSlider({
 }
 
 // Steel Plate Visualizer - Shader-style spectrum display
-function SteelPlateVisualizer({ level }: { level: number }) {
+function SteelPlateVisualizer() {
+  const level = useMeterLevel('output');
   const bars = 24;
 
   // Generate pseudo-random but deterministic heights based on level
@@ -478,12 +486,10 @@ function CarouselArrow({ direction, onClick, disabled }: {
 }
 
 // Cathode Controls - Warm vintage layout
-function CathodeControls({ drive, tone, output, outputLevel }: {
+function CathodeControls({ drive, tone, output }: {
   drive: any;
   tone: any;
   output: any;
-  inputLevel?: number;
-  outputLevel: number;
 }) {
   return (
     <div className="controls-wrapper">
@@ -497,7 +503,7 @@ function CathodeControls({ drive, tone, output, outputLevel }: {
           size="large"
         />
 
-        <CathodeVUMeter level={outputLevel} />
+        <CathodeVUMeter />
 
         <Knob
           value={output.value}
@@ -538,12 +544,10 @@ function CathodeControls({ drive, tone, output, outputLevel }: {
 }
 
 // Filament Controls - Sleek digital layout with oscilloscope
-function FilamentControls({ drive, tone, output, inputLevel, outputLevel }: {
+function FilamentControls({ drive, tone, output }: {
   drive: any;
   tone: any;
   output: any;
-  inputLevel: number;
-  outputLevel: number;
 }) {
   return (
     <div className="controls-wrapper">
@@ -560,15 +564,15 @@ function FilamentControls({ drive, tone, output, inputLevel, outputLevel }: {
               label="Input"
               size="large"
             />
-            <FilamentMiniMeter level={inputLevel} label="In" />
+            <FilamentMiniMeter source="input" label="In" />
           </div>
 
           {/* Center oscilloscope - shows real output level and tone shape */}
-          <FilamentOscilloscope level={outputLevel} color={tone.value} />
+          <FilamentOscilloscope color={tone.value} />
 
           {/* Output section */}
           <div className="filament-section">
-            <FilamentMiniMeter level={outputLevel} label="Out" />
+            <FilamentMiniMeter source="output" label="Out" />
             <Knob
               value={output.value}
               onChange={output.setValue}
@@ -610,12 +614,10 @@ function FilamentControls({ drive, tone, output, inputLevel, outputLevel }: {
 }
 
 // Steel Plate Controls - Wide industrial layout with visualizer
-function SteelPlateControls({ drive, tone, output, outputLevel }: {
+function SteelPlateControls({ drive, tone, output }: {
   drive: any;
   tone: any;
   output: any;
-  inputLevel?: number;
-  outputLevel: number;
 }) {
   return (
     <div className="controls-wrapper">
@@ -649,7 +651,7 @@ function SteelPlateControls({ drive, tone, output, outputLevel }: {
 
         <div className="steelplate-divider" />
 
-        <SteelPlateVisualizer level={outputLevel} />
+        <SteelPlateVisualizer />
       </div>
 
       <div className="effects-strip steelplate">
@@ -696,7 +698,6 @@ function App() {
   const tone = useSliderParam('tone', { defaultValue: 0.5 });
   const output = useSliderParam('output', { defaultValue: 0.5 });
   const bypass = useToggleParam('bypass', { defaultValue: false });
-  const audioLevels = useAudioLevels();
 
   // Sync carousel with preampType parameter from C++
   useEffect(() => {
@@ -751,6 +752,19 @@ function App() {
       [preset.preamp]: preset
     }));
 
+    // Update local state immediately for smooth UI
+    drive.setValue(preset.values.drive);
+    tone.setValue(preset.values.tone);
+    output.setValue(preset.values.output);
+
+    if (isInJuceWebView()) {
+      // The plugin applies the whole preset at once; the knobs follow
+      // through their parameter relays
+      window.__JUCE__!.backend.emitEvent('applyPreset', { id: preset.id });
+      setTimeout(() => setPresetChanging(false), 100);
+      return;
+    }
+
     // Build batch updates for all parameters
     const effectIds = getEffectIds(preset.preamp);
     const updates = [
@@ -763,24 +777,13 @@ function App() {
       }))
     ];
 
-    // Update local state immediately for smooth UI
-    drive.setValue(preset.values.drive);
-    tone.setValue(preset.values.tone);
-    output.setValue(preset.values.output);
-
-    // Apply batch updates to JUCE with slight stagger for visual effect
     applyBatchUpdates(updates, {
-      staggerMs: 15,
       onComplete: () => {
         setTimeout(() => setPresetChanging(false), 100);
       }
     });
   }, [drive, tone, output, getEffectIds]);
 
-  // Use real audio levels from the processor (clamped to 0-1 range for display)
-  const inputLevel = Math.min(1, audioLevels.inputLevel);
-  const outputLevel = Math.min(1, audioLevels.outputLevel);
-
   const navigateTo = useCallback((newIndex: number) => {
     if (isTransitioning || newIndex === currentIndex) return;
     if (newIndex < 0 || newIndex >= PREAMPS.length) return;
@@ -818,7 +821,7 @@ function App() {
   };
 
   const renderControls = () => {
-    const controlProps = { drive, tone, output, inputLevel, outputLevel };
+    const controlProps = { drive, tone, output };
     switch (currentPreamp.id) {
       case 'filament':
         return <FilamentControls {...controlProps} />;
@@ -891,11 +894,17 @@ function App() {
               ))}
             </div>
 
-            <span className="footer-text">v1.0</span>
+            <div className="footer-right">
+              <AnalysisView />
+              <span className="footer-text">v1.0</span>
+            </div>
           </footer>
         </div>
       </div>
 
+      {/* Hidden stage-timing panel (Ctrl+Shift+P) */}
+      <PerformancePanel />
+
       {/* Activation screen overlay - rendered on top until animation completes */}
       {shouldShowActivation && (
         <ActivationScreen
@@ -0,0 +1,88 @@
+import React, { useEffect, useRef } from 'react';
+import { useAnalysisFrame } from '../hooks/useAnalysis';
+
+const SPECTRUM_WIDTH = 128;
+const CURVE_SIZE = 32;
+const HEIGHT = 32;
+
+/**
+ * Compact live view of the preamp: input (dim) and output (bright) spectra,
+ * and the transfer curve - output level against input level - beside them.
+ * Colours follow the active theme's CSS variables.
+ */
+export function AnalysisView() {
+  const frame = useAnalysisFrame();
+  const canvasRef = useRef<HTMLCanvasElement>(null);
+
+  useEffect(() => {
+    const canvas = canvasRef.current;
+    const context = canvas?.getContext('2d');
+    if (!canvas || !context) {
+      return;
+    }
+
+    context.clearRect(0, 0, canvas.width, canvas.height);
+
+    if (frame === null) {
+      return;
+    }
+
+    const styles = getComputedStyle(canvas);
+    const dim = styles.getPropertyValue('--text-dim').trim() || '#5a4a3a';
+    const accent = styles.getPropertyValue('--accent-warm').trim() || '#d4a030';
+
+    const drawSpectrum = (bands: Uint8Array, colour: string) => {
+      context.strokeStyle = colour;
+      context.beginPath();
+      bands.forEach((value, i) => {
+        const x = (i / (bands.length - 1)) * SPECTRUM_WIDTH;
+        const y = HEIGHT - (value / 255) * HEIGHT;
+        if (i === 0) {
+          context.moveTo(x, y);
+        } else {
+          context.lineTo(x, y);
+        }
+      });
+      context.stroke();
+    };
+
+    context.lineWidth = 1;
+    drawSpectrum(frame.input, dim);
+    drawSpectrum(frame.output, accent);
+
+    // Transfer curve, in a square to the right; gaps where the input
+    // never reached that level
+    const left = SPECTRUM_WIDTH + 8;
+    context.strokeStyle = dim;
+    context.strokeRect(left + 0.5, 0.5, CURVE_SIZE - 1, HEIGHT - 1);
+
+    context.strokeStyle = accent;
+    context.beginPath();
+    let drawing = false;
+    frame.curve.forEach((value, i) => {
+      if (value === 0) {
+        drawing = false;
+        return;
+      }
+
+      const x = left + (i / (frame.curve.length - 1)) * CURVE_SIZE;
+      const y = HEIGHT - ((value - 1) / 254) * HEIGHT;
+      if (drawing) {
+        context.lineTo(x, y);
+      } else {
+        context.moveTo(x, y);
+        drawing = true;
+      }
+    });
+    context.stroke();
+  }, [frame]);
+
+  return (
+    <canvas
+      ref={canvasRef}
+      className="analysis-view"
+      width={SPECTRUM_WIDTH + 8 + CURVE_SIZE}
+      height={HEIGHT}
+    />
+  );
+}
@@ -0,0 +1,171 @@
+import React, { useEffect, useState } from 'react';
+import { addCustomEventListener, isInJuceWebView } from '../lib/juce-bridge';
+
+interface StageTiming {
+  name: string;
+  blocks: number;
+  meanNs: number;
+  maxNs: number;
+  histogram: number[];
+}
+
+interface StageTimings {
+  bucketUpperNs: number[];
+  stages: StageTiming[];
+}
+
+interface DeadlineStats {
+  blocks: number;
+  meanPercent: number;
+  p99Percent: number;
+  worstPercent: number;
+  over50: number;
+  over80: number;
+  over100: number;
+  xrunRisk: boolean;
+  tracing: boolean;
+  capturing: boolean;
+}
+
+const POLL_INTERVAL_MS = 500;
+
+function formatMicroseconds(ns: number): string {
+  return (ns / 1000).toFixed(ns < 10000 ? 2 : 1);
+}
+
+/**
+ * Hidden developer panel: processBlock load against the real-time budget,
+ * and per-stage DSP timing from the processor's stage profiler. Toggled
+ * with Ctrl+Shift+P; stage timing is only enabled in the plugin while the
+ * panel is open. The trace recorder is switched separately, since it stays
+ * useful (dumping on deadline misses) with the panel closed.
+ */
+export function PerformancePanel() {
+  const [open, setOpen] = useState(false);
+  const [timings, setTimings] = useState<StageTimings | null>(null);
+  const [deadline, setDeadline] = useState<DeadlineStats | null>(null);
+
+  useEffect(() => {
+    const handleKeyDown = (event: KeyboardEvent) => {
+      if (event.ctrlKey && event.shiftKey && event.key.toLowerCase() === 'p') {
+        event.preventDefault();
+        setOpen(wasOpen => !wasOpen);
+      }
+    };
+
+    window.addEventListener('keydown', handleKeyDown);
+    return () => window.removeEventListener('keydown', handleKeyDown);
+  }, []);
+
+  useEffect(() => {
+    if (!open || !isInJuceWebView()) {
+      return;
+    }
+
+    const backend = window.__JUCE__!.backend;
+    const removeTimingsListener = addCustomEventListener('stageTimings', data => {
+      setTimings(data as StageTimings);
+    });
+    const removeDeadlineListener = addCustomEventListener('deadlineStats', data => {
+      setDeadline(data as DeadlineStats);
+    });
+
+    backend.emitEvent('setStageTiming', { enabled: true });
+    const poll = setInterval(() => {
+      backend.emitEvent('getStageTimings', {});
+      backend.emitEvent('getDeadlineStats', {});
+    }, POLL_INTERVAL_MS);
+
+    return () => {
+      clearInterval(poll);
+      removeTimingsListener();
+      removeDeadlineListener();
+      backend.emitEvent('setStageTiming', { enabled: false });
+      setTimings(null);
+      setDeadline(null);
+    };
+  }, [open]);
+
+  if (!open) {
+    return null;
+  }
+
+  return (
+    <div className="performance-panel">
+      <div className="performance-title">
+        Deadline (% of block budget)
+        <button onClick={() => window.__JUCE__?.backend.emitEvent('resetDeadlineStats', {})}>Reset</button>
+        <button onClick={() => window.__JUCE__?.backend.emitEvent('logDeadlineStats', {})}>Log</button>
+        <button
+          onClick={() => window.__JUCE__?.backend.emitEvent('setTracing', { enabled: !deadline?.tracing })}
+        >
+          {deadline?.tracing ? 'Stop trace' : 'Trace'}
+        </button>
+        {deadline?.tracing && (
+          <button onClick={() => window.__JUCE__?.backend.emitEvent('dumpTrace', {})}>Dump</button>
+        )}
+        <button
+          onClick={() => window.__JUCE__?.backend.emitEvent('setCapture', { enabled: !deadline?.capturing })}
+        >
+          {deadline?.capturing ? 'Stop capture' : 'Capture'}
+        </button>
+      </div>
+      {deadline === null || deadline.blocks === 0 ? (
+        <div className="performance-empty">Waiting for audio…</div>
+      ) : (
+        <div className={`performance-deadline ${deadline.xrunRisk ? 'at-risk' : ''}`}>
+          mean {deadline.meanPercent.toFixed(1)} · p99 {deadline.p99Percent} · worst {deadline.worstPercent.toFixed(1)}
+          {' '}· over 50/80/100: {deadline.over50}/{deadline.over80}/{deadline.over100}
+          {deadline.xrunRisk ? ' · XRUN RISK' : ''}
+        </div>
+      )}
+
+      <div className="performance-title">Stage timing (µs per block)</div>
+      {timings === null || timings.stages.length === 0 ? (
+        <div className="performance-empty">Waiting for audio…</div>
+      ) : (
+        <table>
+          <thead>
+            <tr>
+              <th>Stage</th>
+              <th>Mean</th>
+              <th>Max</th>
+              <th>Blocks</th>
+              <th>Histogram</th>
+            </tr>
+          </thead>
+          <tbody>
+            {timings.stages.map(stage => {
+              const peak = Math.max(1, ...stage.histogram);
+              const first = stage.histogram.findIndex(count => count > 0);
+              const last = stage.histogram.length - 1
+                - [...stage.histogram].reverse().findIndex(count => count > 0);
+
+              return (
+                <tr key={stage.name}>
+                  <td>{stage.name}</td>
+                  <td>{formatMicroseconds(stage.meanNs)}</td>
+                  <td>{formatMicroseconds(stage.maxNs)}</td>
+                  <td>{stage.blocks}</td>
+                  <td>
+                    <div
+                      className="performance-histogram"
+                      title={first >= 0
+                        ? `${formatMicroseconds(first > 0 ? timings.bucketUpperNs[first - 1] : 0)}`
+                          + `-${formatMicroseconds(timings.bucketUpperNs[last])} µs`
+                        : ''}
+                    >
+                      {stage.histogram.map((count, bucket) => (
+                        <span key={bucket} style={{ height: `${(count / peak) * 100}%` }} />
+                      ))}
+                    </div>
+                  </td>
+                </tr>
+              );
+            })}
+          </tbody>
+        </table>
+      )}
+    </div>
+  );
+}
@@ -0,0 +1,93 @@
+/**
+ * React Hook for the Spectrum and Transfer-Curve Feed
+ * Receives analysis frames from the JUCE processor via WebView events
+ *
+ * Each frame is a base64 string of bytes, laid out as in
+ * Source/AnalysisFeed.h: input spectrum, output spectrum, then the transfer
+ * curve. Frames are coalesced to one per animation frame, like the meters.
+ */
+
+import { useSyncExternalStore } from 'react';
+import { addCustomEventListener, isInJuceWebView } from '../lib/juce-bridge';
+
+export const ANALYSIS_BANDS = 64;
+export const ANALYSIS_CURVE_POINTS = 64;
+
+export interface AnalysisFrame {
+  /** Input spectrum, log-spaced 20Hz-20kHz, 0-255 over -90..0 dB */
+  input: Uint8Array;
+  /** Output spectrum, same scale */
+  output: Uint8Array;
+  /** Mean output per input level from -1 to 1: 1-255 over -1..1, 0 = no data */
+  curve: Uint8Array;
+}
+
+let frame: AnalysisFrame | null = null;
+let pendingData: string | null = null;
+let frameRequested = false;
+let removeListener: (() => void) | null = null;
+const subscribers = new Set<() => void>();
+
+function publishPendingFrame(): void {
+  frameRequested = false;
+
+  if (pendingData === null) {
+    return;
+  }
+
+  const binary = atob(pendingData);
+  pendingData = null;
+
+  const bytes = new Uint8Array(binary.length);
+  for (let i = 0; i < binary.length; i++) {
+    bytes[i] = binary.charCodeAt(i);
+  }
+
+  if (bytes.length < 2 * ANALYSIS_BANDS + ANALYSIS_CURVE_POINTS) {
+    return;
+  }
+
+  frame = {
+    input: bytes.subarray(0, ANALYSIS_BANDS),
+    output: bytes.subarray(ANALYSIS_BANDS, 2 * ANALYSIS_BANDS),
+    curve: bytes.subarray(2 * ANALYSIS_BANDS, 2 * ANALYSIS_BANDS + ANALYSIS_CURVE_POINTS),
+  };
+
+  subscribers.forEach(notify => notify());
+}
+
+function handleFrame(data: unknown): void {
+  if (typeof data !== 'string') {
+    return;
+  }
+
+  // Decoded at the next animation frame, and only the newest one
+  pendingData = data;
+
+  if (!frameRequested) {
+    frameRequested = true;
+    requestAnimationFrame(publishPendingFrame);
+  }
+}
+
+function subscribe(notify: () => void): () => void {
+  subscribers.add(notify);
+
+  if (removeListener === null && isInJuceWebView()) {
+    removeListener = addCustomEventListener('analysisFrame', handleFrame);
+  }
+
+  return () => {
+    subscribers.delete(notify);
+
+    if (subscribers.size === 0 && removeListener !== null) {
+      removeListener();
+      removeListener = null;
+    }
+  };
+}
+
+/** The newest analysis frame, or null until one has arrived */
+export function useAnalysisFrame(): AnalysisFrame | null {
+  return useSyncExternalStore(subscribe, () => frame);
+}
@@ -1,62 +1,98 @@
 /**
  * React Hook for Real-time Audio Level Metering
  * Receives level data from the JUCE processor via WebView events
+ *
+ * The processor sends a packed array [inL, inR, outL, outR] in thousandths
+ * of full scale, and only when a level has moved. Updates are coalesced to
+ * one per animation frame, and only the meter components reading a level
+ * re-render, not the whole App.
  */
 
-import { useState, useEffect } from 'react';
+import { useSyncExternalStore } from 'react';
 import { addCustomEventListener, isInJuceWebView } from '../lib/juce-bridge';
 
+export type MeterSource = 'input' | 'output';
+
 interface AudioLevels {
-  inputLevel: number;
-  outputLevel: number;
   inputLevelL: number;
   inputLevelR: number;
   outputLevelL: number;
   outputLevelR: number;
 }
 
-interface UseAudioLevelsReturn extends AudioLevels {
-  isConnected: boolean;
+let levels: AudioLevels = {
+  inputLevelL: 0,
+  inputLevelR: 0,
+  outputLevelL: 0,
+  outputLevelR: 0,
+};
+
+let pendingLevels: AudioLevels | null = null;
+let frameRequested = false;
+let removeListener: (() => void) | null = null;
+const subscribers = new Set<() => void>();
+
+function publishPendingLevels(): void {
+  frameRequested = false;
+
+  if (pendingLevels === null) {
+    return;
+  }
+
+  levels = pendingLevels;
+  pendingLevels = null;
+  subscribers.forEach(notify => notify());
 }
 
-/**
- * Hook to receive real-time audio levels from the JUCE processor.
- * Updates at ~30fps when audio is playing.
- */
-export function useAudioLevels(): UseAudioLevelsReturn {
-  const [levels, setLevels] = useState<AudioLevels>({
-    inputLevel: 0,
-    outputLevel: 0,
-    inputLevelL: 0,
-    inputLevelR: 0,
-    outputLevelL: 0,
-    outputLevelR: 0,
-  });
+function handleLevels(data: unknown): void {
+  const packed = data as number[];
+  if (!Array.isArray(packed) || packed.length < 4) {
+    return;
+  }
 
-  const isConnected = isInJuceWebView();
+  // Only the latest values matter: anything older is dropped at the next frame
+  pendingLevels = {
+    inputLevelL: packed[0] / 1000,
+    inputLevelR: packed[1] / 1000,
+    outputLevelL: packed[2] / 1000,
+    outputLevelR: packed[3] / 1000,
+  };
 
-  useEffect(() => {
-    if (!isConnected) {
-      return;
-    }
+  if (!frameRequested) {
+    frameRequested = true;
+    requestAnimationFrame(publishPendingLevels);
+  }
+}
 
-    const removeListener = addCustomEventListener('audioLevels', (data) => {
-      const levelData = data as AudioLevels;
-      setLevels({
-        inputLevel: levelData.inputLevel ?? 0,
-        outputLevel: levelData.outputLevel ?? 0,
-        inputLevelL: levelData.inputLevelL ?? 0,
-        inputLevelR: levelData.inputLevelR ?? 0,
-        outputLevelL: levelData.outputLevelL ?? 0,
-        outputLevelR: levelData.outputLevelR ?? 0,
-      });
-    });
-
-    return removeListener;
-  }, [isConnected]);
-
-  return {
-    ...levels,
-    isConnected,
+function subscribe(notify: () => void): () => void {
+  subscribers.add(notify);
+
+  // One event listener, shared by every mounted meter
+  if (removeListener === null && isInJuceWebView()) {
+    removeListener = addCustomEventListener('audioLevels', handleLevels);
+  }
+
+  return () => {
+    subscribers.delete(notify);
+
+    if (subscribers.size === 0 && removeListener !== null) {
+      removeListener();
+      removeListener = null;
+    }
   };
 }
+
+/**
+ * Peak level of the input or output (louder of the two channels), clamped
+ * to 0-1 for display. The calling component re-renders only when this
+ * value changes.
+ */
+export function useMeterLevel(source: MeterSource): number {
+  return useSyncExternalStore(subscribe, () => {
+    const level = source === 'input'
+      ? Math.max(levels.inputLevelL, levels.inputLevelR)
+      : Math.max(levels.outputLevelL, levels.outputLevelR);
+
+    return Math.min(1, level);
+  });
+}
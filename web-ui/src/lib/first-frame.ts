@@ -0,0 +1,27 @@
+/**
+ * Editor open latency reporting
+ *
+ * The plugin times how long its editor takes to show a painted UI. A freshly
+ * loaded page reports its first frame on its own; a page that was kept alive
+ * between editor opens is asked again with 'editorShown'.
+ */
+
+import { addCustomEventListener, isInJuceWebView } from './juce-bridge';
+
+function emitAfterNextPaint(): void {
+  // The second frame callback runs once the first frame has been presented
+  requestAnimationFrame(() => {
+    requestAnimationFrame(() => {
+      window.__JUCE__!.backend.emitEvent('editorFirstFrame', {});
+    });
+  });
+}
+
+export function startFirstFrameReporting(): void {
+  if (!isInJuceWebView()) {
+    return;
+  }
+
+  addCustomEventListener('editorShown', emitAfterNextPaint);
+  emitAfterNextPaint();
+}
@@ -1,6 +1,7 @@
 import React from 'react'
 import ReactDOM from 'react-dom/client'
 import App from './App'
+import { startFirstFrameReporting } from './lib/first-frame'
 import './index.css'
 
 ReactDOM.createRoot(document.getElementById('root')!).render(
@@ -8,3 +9,5 @@ ReactDOM.createRoot(document.getElementById('root')!).render(
     <App />
   </React.StrictMode>
 )
+
+startFirstFrameReporting()
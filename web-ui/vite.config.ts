@@ -17,6 +17,10 @@ export default defineConfig({
   },
   server: {
     port: 5173,
-    strictPort: true
+    strictPort: true,
+    fs: {
+      // The preset bank is shared with the plugin from ../Resources
+      allow: ['..']
+    }
   }
 })